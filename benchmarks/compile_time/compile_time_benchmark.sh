@@ -0,0 +1,148 @@
+#!/bin/bash
+
+################################################################################
+# Copyright 2021 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+################################################################################
+#
+# Measures the compile time cost of JNI Bind for synthetic bindings.
+#
+# For every configuration a translation unit is generated (see
+# generate_binding.sh) and compiled with clang's -ftime-trace.  One CSV row is
+# printed per configuration:
+#
+#   config,wall_seconds,peak_rss_kb,instantiate_class,instantiate_function,
+#   text_bytes
+#
+# Traces are left in the output directory so they can be loaded into
+# chrome://tracing or Perfetto for a per-template breakdown.
+#
+# text_bytes is the size of the object's code.  To compare code size, pass e.g.
+# "-O2 -DJNI_BIND_SHARED_INVOKE_TRAMPOLINES" in EXTRA_CXXFLAGS.  To compare
+# per translation unit cost with method and field bodies compiled out of line,
+# pass "-DJNI_BIND_OUT_OF_LINE_HELPERS" (only declarations are needed to
+# compile, see implementation/jni_helper/out_of_line_helpers.h).
+#
+# Environment:
+#   CXX:              Compiler to use (must be clang, defaults to clang++).
+#   JAVA_HOME:        JDK used for <jni.h>.
+#   EXTRA_CXXFLAGS:   Additional flags (e.g. -D feature macros to compare).
+#   OUT_DIR:          Where to put sources and traces (defaults to a tmp dir).
+#   USE_MODULE:       If 1, `import jni_bind;` (see jni_bind.cppm) rather than
+#                     including jni_bind.h.  The module is precompiled once and
+#                     that cost is reported as its own "module" row.
+#
+# $@ Configurations as "classes,methods,params[,overloads[,fields]]".  If none
+#    are given, a default sweep is used.
+#
+# e.g. ./compile_time_benchmark.sh 1,10,1 1,100,2 10,100,2,3
+
+script_dir=$(cd "$(dirname "$0")" && pwd)
+repo_root=$(cd "$script_dir/../.." && pwd)
+
+cxx=${CXX:-clang++}
+out_dir=${OUT_DIR:-$(mktemp -d /tmp/jni_bind_compile_time.XXXXXX)}
+java_home=${JAVA_HOME:-$(dirname "$(dirname "$(readlink -f "$(which javac)")")")}
+
+case "$(uname -s)" in
+  Darwin) jni_md_dir="darwin" ;;
+  *) jni_md_dir="linux" ;;
+esac
+
+configs=("$@")
+if [[ ${#configs[@]} -eq 0 ]]; then
+  configs=("1,10,1" "1,50,2" "1,100,2" "1,300,2" "10,100,2" "100,10,2")
+fi
+
+if ! $cxx --version | grep -q clang; then
+  echo "$cxx is not clang (clang is required for -ftime-trace)." >&2
+  exit 1
+fi
+
+# GNU time is required for peak RSS.
+if [[ -x /usr/bin/time ]]; then
+  time_cmd=/usr/bin/time
+elif which gtime > /dev/null 2>&1; then
+  time_cmd=gtime
+else
+  echo "GNU time is required for peak RSS measurements." >&2
+  exit 1
+fi
+
+################################################################################
+# $1 Trace file.
+# $2 Event name.
+count_events() {
+  grep -o "\"name\":\"$2\"" "$1" | wc -l | tr -d ' '
+}
+
+include_flags=(
+  -I"$repo_root"
+  -I"$java_home/include" -I"$java_home/include/$jni_md_dir"
+)
+std_flag="-std=c++17"
+
+################################################################################
+# Main.
+################################################################################
+echo "config,wall_seconds,peak_rss_kb,instantiate_class,instantiate_function,text_bytes"
+
+if [[ "$USE_MODULE" == "1" ]]; then
+  std_flag="-std=c++20"
+  pcm="$out_dir/jni_bind.pcm"
+
+  $time_cmd -f "%e %M" -o "$out_dir/time_module.txt" \
+    $cxx $std_flag --precompile -x c++-module \
+      "${include_flags[@]}" $EXTRA_CXXFLAGS \
+      "$repo_root/jni_bind.cppm" -o "$pcm" || exit 1
+
+  read -r wall rss < "$out_dir/time_module.txt"
+  echo "module,$wall,$rss,,,"
+
+  EXTRA_CXXFLAGS="$EXTRA_CXXFLAGS -fmodule-file=jni_bind=$pcm"
+fi
+
+for config in "${configs[@]}"
+do
+  IFS=',' read -r -a dims <<< "$config"
+  name=$(tr ',' 'x' <<< "$config")
+  src="$out_dir/binding_${name}.cc"
+  obj="$out_dir/binding_${name}.o"
+
+  "$script_dir/generate_binding.sh" "${dims[@]}" > "$src"
+  if [[ "$USE_MODULE" == "1" ]]; then
+    sed -i.bak 's/^#include "jni_bind.h"$/import jni_bind;/' "$src"
+  fi
+
+  $time_cmd -f "%e %M" -o "$out_dir/time_${name}.txt" \
+    $cxx $std_flag -c -ftime-trace -ftime-trace-granularity=0 \
+      "${include_flags[@]}" $EXTRA_CXXFLAGS \
+      "$src" -o "$obj"
+
+  if [[ $? -ne 0 ]]; then
+    echo "$name,FAILED,,,,"
+    continue
+  fi
+
+  read -r wall rss < "$out_dir/time_${name}.txt"
+  trace="$out_dir/binding_${name}.json"
+
+  text=$(size "$obj" | awk 'NR == 2 { print $1 }')
+
+  echo "$name,$wall,$rss,$(count_events "$trace" InstantiateClass)," \
+       "$(count_events "$trace" InstantiateFunction),$text" | tr -d ' '
+done
+
+echo "Traces written to $out_dir." >&2
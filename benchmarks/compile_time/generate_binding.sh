@@ -0,0 +1,142 @@
+#!/bin/bash
+
+################################################################################
+# Copyright 2021 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+################################################################################
+#
+# Prints a synthetic translation unit which declares a large JNI Bind binding
+# and a call site for every declared method.  The output is only intended to be
+# compiled (never run) and is used to measure the front end cost of JNI Bind.
+#
+# $1 Number of classes.
+# $2 Number of methods per class.
+# $3 Number of params per overload.
+# $4 Number of overloads per method (optional, defaults to 2).
+# $5 Number of fields per class (optional, defaults to 0).
+
+num_classes=$1
+num_methods=$2
+num_params=$3
+num_overloads=${4:-2}
+num_fields=${5:-0}
+
+if [[ -z "$num_classes" || -z "$num_methods" || -z "$num_params" ]]; then
+  echo "Usage: $0 <classes> <methods> <params> [overloads] [fields]" >&2
+  exit 1
+fi
+
+# Overloads are distinguished solely by their params.
+if [[ $num_params -eq 0 ]]; then
+  num_overloads=1
+fi
+
+# Types are rotated per overload so every overload of a method is distinct.
+param_types=(jint jfloat jlong jdouble jboolean jshort)
+param_values=("1" "1.f" "jlong{1}" "1.0" "true" "jshort{1}")
+num_types=${#param_types[@]}
+
+################################################################################
+# $1 Overload index.
+print_overload() {
+  local overload_idx=$1
+  local params=""
+  for (( p=0; p<$num_params; p++ ))
+  do
+    local type=${param_types[$(( (overload_idx + p) % num_types ))]}
+    if [[ $p -ne 0 ]]; then
+      params+=", "
+    fi
+    params+="${type}{}"
+  done
+
+  if [[ $num_params -eq 0 ]]; then
+    echo "        jni::Overload{jni::Return<void>{}, jni::Params<>{}},"
+  else
+    echo "        jni::Overload{jni::Return<void>{}, jni::Params{${params}}},"
+  fi
+}
+
+################################################################################
+# $1 Overload index.
+print_call_args() {
+  local overload_idx=$1
+  local args=""
+  for (( p=0; p<$num_params; p++ ))
+  do
+    args+=", ${param_values[$(( (overload_idx + p) % num_types ))]}"
+  done
+
+  echo -n "$args"
+}
+
+################################################################################
+# Main.
+################################################################################
+cat <<EOF
+// Generated by generate_binding.sh, do not edit.
+// Classes: $num_classes, Methods: $num_methods, Params: $num_params,
+// Overloads: $num_overloads, Fields: $num_fields.
+
+#include "jni_bind.h"
+
+namespace jni::benchmark {
+
+EOF
+
+for (( c=0; c<$num_classes; c++ ))
+do
+  echo "// clang-format off"
+  echo "inline constexpr jni::Class kClass${c}{"
+  echo "    \"com/jnibind/benchmark/Class${c}\","
+
+  for (( m=0; m<$num_methods; m++ ))
+  do
+    echo "    jni::Method{"
+    echo "        \"method${m}\","
+    for (( o=0; o<$num_overloads; o++ ))
+    do
+      print_overload $(( m + o ))
+    done
+    echo "    },"
+  done
+
+  for (( f=0; f<$num_fields; f++ ))
+  do
+    echo "    jni::Field{\"field${f}\", ${param_types[$(( f % num_types ))]}{}},"
+  done
+
+  echo "};"
+  echo "// clang-format on"
+  echo ""
+
+  echo "void CallSites${c}(jobject object) {"
+  echo "  jni::LocalObject<kClass${c}> obj{object};"
+  for (( m=0; m<$num_methods; m++ ))
+  do
+    for (( o=0; o<$num_overloads; o++ ))
+    do
+      echo "  obj(\"method${m}\"$(print_call_args $(( m + o ))));"
+    done
+  done
+  for (( f=0; f<$num_fields; f++ ))
+  do
+    echo "  obj[\"field${f}\"].Get();"
+  done
+  echo "}"
+  echo ""
+done
+
+echo "}  // namespace jni::benchmark"
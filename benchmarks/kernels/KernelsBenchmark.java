@@ -0,0 +1,118 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.jnibind.benchmark;
+
+import java.util.Arrays;
+import java.util.Random;
+import java.util.function.Supplier;
+
+/**
+ * Compares jni::kernels against the equivalent Java code.
+ *
+ * <p>Prints "kernel,size,java_ns,native_ns" per kernel and size, where times are the median of
+ * several timed runs after a warm up.
+ */
+public final class KernelsBenchmark {
+  private static final int[] SIZES = {1 << 10, 1 << 16, 1 << 20};
+  private static final int WARMUP_RUNS = 50;
+  private static final int TIMED_RUNS = 21;
+
+  static {
+    System.loadLibrary("kernels_benchmark_jni");
+  }
+
+  private KernelsBenchmark() {}
+
+  static native long nativeSum(int[] array);
+
+  static native long nativeParallelSum(int[] array);
+
+  static native int nativeMax(int[] array);
+
+  static native double nativeDot(double[] lhs, double[] rhs);
+
+  static native void nativeSort(int[] array);
+
+  // Blackhole so results aren't optimised away.
+  private static long sink;
+
+  private static long medianNanos(Supplier<Object> fn) {
+    for (int i = 0; i < WARMUP_RUNS; i++) {
+      sink += fn.get().hashCode();
+    }
+
+    long[] times = new long[TIMED_RUNS];
+    for (int i = 0; i < TIMED_RUNS; i++) {
+      long start = System.nanoTime();
+      sink += fn.get().hashCode();
+      times[i] = System.nanoTime() - start;
+    }
+
+    Arrays.sort(times);
+    return times[TIMED_RUNS / 2];
+  }
+
+  private static void report(String kernel, int size, Supplier<Object> java,
+      Supplier<Object> nativeFn) {
+    System.out.println(
+        kernel + "," + size + "," + medianNanos(java) + "," + medianNanos(nativeFn));
+  }
+
+  public static void main(String[] args) {
+    Random random = new Random(0);
+    System.out.println("kernel,size,java_ns,native_ns");
+
+    for (int size : SIZES) {
+      int[] ints = random.ints(size).toArray();
+      double[] lhs = random.doubles(size).toArray();
+      double[] rhs = random.doubles(size).toArray();
+
+      report("sum", size, () -> Arrays.stream(ints).asLongStream().sum(), () -> nativeSum(ints));
+      report(
+          "parallel_sum",
+          size,
+          () -> Arrays.stream(ints).parallel().asLongStream().sum(),
+          () -> nativeParallelSum(ints));
+      report("max", size, () -> Arrays.stream(ints).max().getAsInt(), () -> nativeMax(ints));
+      report(
+          "dot",
+          size,
+          () -> {
+            double acc = 0;
+            for (int i = 0; i < size; i++) {
+              acc += lhs[i] * rhs[i];
+            }
+            return acc;
+          },
+          () -> nativeDot(lhs, rhs));
+      report(
+          "sort",
+          size,
+          () -> {
+            int[] copy = ints.clone();
+            Arrays.sort(copy);
+            return copy[0];
+          },
+          () -> {
+            int[] copy = ints.clone();
+            nativeSort(copy);
+            return copy[0];
+          });
+    }
+
+    System.err.println(sink);
+  }
+}
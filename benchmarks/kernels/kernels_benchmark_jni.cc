@@ -0,0 +1,73 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <thread>  // NOLINT
+
+#include "jni_bind.h"
+
+namespace {
+
+namespace kernels = ::jni::kernels;
+
+using ::jni::LocalArray;
+
+static std::unique_ptr<jni::JvmRef<jni::kDefaultJvm>> jvm;
+
+std::size_t NumThreads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* pjvm, void* reserved) {
+  jvm.reset(new jni::JvmRef<jni::kDefaultJvm>(pjvm));
+  return JNI_VERSION_1_6;
+}
+
+JNIEXPORT jlong JNICALL Java_com_jnibind_benchmark_KernelsBenchmark_nativeSum(
+    JNIEnv*, jclass, jintArray array) {
+  return kernels::Sum(LocalArray<jint>{array});
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_jnibind_benchmark_KernelsBenchmark_nativeParallelSum(
+    JNIEnv*, jclass, jintArray array) {
+  LocalArray<jint> arr{array};
+  return kernels::ParallelSum(arr.Pin(false), NumThreads());
+}
+
+JNIEXPORT jint JNICALL Java_com_jnibind_benchmark_KernelsBenchmark_nativeMax(
+    JNIEnv*, jclass, jintArray array) {
+  auto min_max = kernels::MinMax(LocalArray<jint>{array});
+  return min_max ? min_max->second : 0;
+}
+
+JNIEXPORT jdouble JNICALL Java_com_jnibind_benchmark_KernelsBenchmark_nativeDot(
+    JNIEnv*, jclass, jdoubleArray lhs, jdoubleArray rhs) {
+  return kernels::Dot(LocalArray<jdouble>{lhs}, LocalArray<jdouble>{rhs});
+}
+
+JNIEXPORT void JNICALL Java_com_jnibind_benchmark_KernelsBenchmark_nativeSort(
+    JNIEnv*, jclass, jintArray array) {
+  kernels::Sort(LocalArray<jint>{array});
+}
+
+}  // extern "C"
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.jnibind.benchmark;
+
+import java.util.Arrays;
+
+/**
+ * Measures how JNI Bind's ID caches and ThreadGuard scale across native threads.
+ *
+ * <p>Prints "path,threads,calls_per_sec,speedup" per path and thread count, where speedup is
+ * relative to a single thread. "cold" rebuilds the JvmRef before each run so every thread races
+ * the first lookup of every ID, "warm" only hits already cached IDs.
+ */
+public final class ScalabilityBenchmark {
+  private static final int[] THREAD_COUNTS = {1, 2, 4, 8, 16, 32, 64, 128};
+  private static final int WARM_ITERATIONS = 2000;
+  private static final int CALLS_PER_ITERATION = 8;
+  private static final int WARMUP_RUNS = 5;
+  private static final int TIMED_RUNS = 11;
+
+  static {
+    System.loadLibrary("scalability_benchmark_jni");
+  }
+
+  private ScalabilityBenchmark() {}
+
+  static native long nativeRun(Target target, int numThreads, int iterations, boolean cold);
+
+  /** Trivial methods and fields so that time is spent in the native call path. */
+  static final class Target {
+    int f0;
+    long f1;
+
+    void m0() {}
+
+    int m1() {
+      return f0;
+    }
+
+    void m2(int val) {}
+
+    long m3(long val) {
+      return val;
+    }
+
+    void m4(float val) {}
+
+    double m5(double val) {
+      return val;
+    }
+  }
+
+  private static long medianNanos(Target target, int threads, int iterations, boolean cold) {
+    for (int i = 0; i < WARMUP_RUNS; i++) {
+      nativeRun(target, threads, iterations, cold);
+    }
+
+    long[] times = new long[TIMED_RUNS];
+    for (int i = 0; i < TIMED_RUNS; i++) {
+      times[i] = nativeRun(target, threads, iterations, cold);
+    }
+
+    Arrays.sort(times);
+    return times[TIMED_RUNS / 2];
+  }
+
+  private static void report(String path, Target target, int iterations, boolean cold) {
+    double baseline = 0;
+    for (int threads : THREAD_COUNTS) {
+      long nanos = medianNanos(target, threads, iterations, cold);
+      double callsPerSec = (double) threads * iterations * CALLS_PER_ITERATION * 1e9 / nanos;
+      if (threads == 1) {
+        baseline = callsPerSec;
+      }
+
+      System.out.printf("%s,%d,%.0f,%.2f%n", path, threads, callsPerSec, callsPerSec / baseline);
+    }
+  }
+
+  public static void main(String[] args) {
+    Target target = new Target();
+    System.out.println("path,threads,calls_per_sec,speedup");
+
+    report("cold", target, 1, true);
+    report("warm", target, WARM_ITERATIONS, false);
+  }
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "jni_bind.h"
+
+namespace {
+
+using ::jni::Field;
+using ::jni::GlobalObject;
+using ::jni::Method;
+using ::jni::Params;
+using ::jni::PromoteToGlobal;
+using ::jni::Return;
+using ::jni::ThreadGuard;
+
+static std::unique_ptr<jni::JvmRef<jni::kDefaultJvm>> jvm;
+static JavaVM* java_vm = nullptr;
+
+// clang-format off
+constexpr jni::Class kTarget{
+    "com/jnibind/benchmark/ScalabilityBenchmark$Target",
+    Method{"m0", Return<void>{}},
+    Method{"m1", Return<int>{}},
+    Method{"m2", Return<void>{}, Params<int>{}},
+    Method{"m3", Return<jlong>{}, Params<jlong>{}},
+    Method{"m4", Return<void>{}, Params<float>{}},
+    Method{"m5", Return<double>{}, Params<double>{}},
+    Field{"f0", int{}},
+    Field{"f1", jlong{}},
+};
+// clang-format on
+
+void CallEachId(GlobalObject<kTarget>& target) {
+  target("m0");
+  target("m1");
+  target("m2", 1);
+  target("m3", jlong{1});
+  target("m4", 1.f);
+  target("m5", 1.0);
+  target["f0"].Get();
+  target["f1"].Get();
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* pjvm, void* reserved) {
+  java_vm = pjvm;
+  jvm.reset(new jni::JvmRef<jni::kDefaultJvm>(pjvm));
+  return JNI_VERSION_1_6;
+}
+
+// Runs |iterations| passes over every ID of |target| on |num_threads| native
+// threads (each attached with a ThreadGuard) and returns the elapsed nanos.
+// If |cold| the JvmRef is rebuilt first, so every ID is looked up concurrently.
+JNIEXPORT jlong JNICALL
+Java_com_jnibind_benchmark_ScalabilityBenchmark_nativeRun(
+    JNIEnv*, jclass, jobject target, jint num_threads, jint iterations,
+    jboolean cold) {
+  if (cold) {
+    jvm = nullptr;
+    jvm.reset(new jni::JvmRef<jni::kDefaultJvm>(java_vm));
+  }
+
+  GlobalObject<kTarget> global_target{PromoteToGlobal{}, target};
+
+  std::atomic<jint> ready{0};
+  std::atomic<bool> go{false};
+
+  std::vector<std::thread> threads;
+  for (jint i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&]() {
+      ThreadGuard thread_guard{};
+      ready.fetch_add(1);
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+
+      for (jint j = 0; j < iterations; ++j) {
+        CallEachId(global_target);
+      }
+    });
+  }
+
+  while (ready.load() != num_threads) {
+    std::this_thread::yield();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  go.store(true, std::memory_order_release);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // extern "C"
@@ -0,0 +1,258 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Class;
+using ::jni::DefaultRefs;
+using ::jni::Fake;
+using ::jni::Field;
+using ::jni::GlobalObject;
+using ::jni::JvmRef;
+using ::jni::Method;
+using ::jni::Params;
+using ::jni::PromoteToGlobal;
+using ::jni::ThreadGuard;
+using ::jni::test::AsGlobal;
+using ::jni::test::JniTest;
+using ::testing::AnyNumber;
+
+static constexpr std::size_t kThreadCounts[] = {1, 2, 4, 8, 16, 32, 64, 128};
+static constexpr std::size_t kWarmIterations = 32;
+
+// Every class, method and field below is a distinct cold ID, so each round
+// races on distinct `DoubleLockedValue`s which share the teardown lists.
+// clang-format off
+static constexpr Class kClass0{
+    "com/jnibind/stress/Class0",
+    Method{"m0", jni::Return<void>{}}, Method{"m1", jni::Return<int>{}},
+    Method{"m2", jni::Return<void>{}, Params<int>{}},
+    Method{"m3", jni::Return<void>{}, Params<float>{}},
+    Field{"f0", int{}}, Field{"f1", float{}},
+};
+
+static constexpr Class kClass1{
+    "com/jnibind/stress/Class1",
+    Method{"m0", jni::Return<void>{}}, Method{"m1", jni::Return<int>{}},
+    Method{"m2", jni::Return<void>{}, Params<int>{}},
+    Method{"m3", jni::Return<void>{}, Params<float>{}},
+    Field{"f0", int{}}, Field{"f1", float{}},
+};
+
+static constexpr Class kClass2{
+    "com/jnibind/stress/Class2",
+    Method{"m0", jni::Return<void>{}}, Method{"m1", jni::Return<int>{}},
+    Method{"m2", jni::Return<void>{}, Params<int>{}},
+    Method{"m3", jni::Return<void>{}, Params<float>{}},
+    Field{"f0", int{}}, Field{"f1", float{}},
+};
+
+static constexpr Class kClass3{
+    "com/jnibind/stress/Class3",
+    Method{"m0", jni::Return<void>{}}, Method{"m1", jni::Return<int>{}},
+    Method{"m2", jni::Return<void>{}, Params<int>{}},
+    Method{"m3", jni::Return<void>{}, Params<float>{}},
+    Field{"f0", int{}}, Field{"f1", float{}},
+};
+// clang-format on
+
+// Calls made by `CallEachId` per object.
+static constexpr std::size_t kCallsPerObject = 6;
+
+template <const auto& class_v>
+void CallEachId(GlobalObject<class_v>& obj) {
+  obj("m0");
+  obj("m1");
+  obj("m2", 1);
+  obj("m3", 1.f);
+  obj["f0"].Get();
+  obj["f1"].Get();
+}
+
+struct Objects {
+  GlobalObject<kClass0> obj_0{PromoteToGlobal{}, Fake<jobject>(1)};
+  GlobalObject<kClass1> obj_1{PromoteToGlobal{}, Fake<jobject>(2)};
+  GlobalObject<kClass2> obj_2{PromoteToGlobal{}, Fake<jobject>(3)};
+  GlobalObject<kClass3> obj_3{PromoteToGlobal{}, Fake<jobject>(4)};
+
+  void CallAll() {
+    CallEachId(obj_0);
+    CallEachId(obj_1);
+    CallEachId(obj_2);
+    CallEachId(obj_3);
+  }
+};
+
+static constexpr std::size_t kCallsPerRound = 4 * kCallsPerObject;
+
+// Spins up |num_threads| threads which each `ThreadGuard` (attaching) and then
+// invoke |work| at the same time. Returns elapsed seconds for all threads.
+template <typename Work>
+double RunThreads(std::size_t num_threads, Work work) {
+  std::atomic<std::size_t> ready{0};
+  std::atomic<bool> go{false};
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&]() {
+      ThreadGuard thread_guard{};
+      ready.fetch_add(1);
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      work();
+    });
+  }
+
+  while (ready.load() != num_threads) {
+    std::this_thread::yield();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  go.store(true, std::memory_order_release);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+// Stresses the ID caches, their teardown lists and `ThreadGuard` attach
+// across 1..128 threads. Intended to be run under TSAN (see BUILD), and prints
+// a "path,threads,calls_per_sec" row per run.
+//
+// Note, calls through the mock env take a gMock wide lock, so the printed
+// throughput is for spotting regressions in the cold path only. See
+// ScalabilityBenchmark for scaling against a real JVM.
+class ScalabilityStressTest : public JniTest {
+ public:
+  void SetUp() override {
+    JniTest::SetUp();
+
+    // The fixture's default isn't safe to race, and classes are (correctly)
+    // promoted once per round.
+    ON_CALL(*env_, NewGlobalRef).WillByDefault([](jobject object) {
+      return AsGlobal(object);
+    });
+    EXPECT_CALL(*env_, DeleteGlobalRef).Times(AnyNumber());
+
+    // Lookups are counted, as method and field IDs are cached per `JvmEpoch`
+    // rather than registered for teardown.
+    ON_CALL(*env_, GetMethodID).WillByDefault([this](jclass, const char*,
+                                                     const char*) {
+      method_lookups_.fetch_add(1);
+      return Fake<jmethodID>();
+    });
+    ON_CALL(*env_, GetFieldID).WillByDefault([this](jclass, const char*,
+                                                    const char*) {
+      field_lookups_.fetch_add(1);
+      return Fake<jfieldID>();
+    });
+  }
+
+  // Replaces the JvmRef (as a restart would), dropping all cached IDs.
+  void ResetJvmRef() {
+    default_jvm_ref_ = nullptr;
+    default_jvm_ref_ = std::make_unique<JvmRef<jni::kDefaultJvm>>(jvm_.get());
+    method_lookups_ = 0;
+    field_lookups_ = 0;
+  }
+
+ protected:
+  std::atomic<std::size_t> method_lookups_{0};
+  std::atomic<std::size_t> field_lookups_{0};
+};
+
+TEST_F(ScalabilityStressTest, ColdPathCachesEveryIdExactlyOnce) {
+  std::size_t expected_classes = 0;
+  std::size_t expected_methods = 0;
+  std::size_t expected_fields = 0;
+
+  for (std::size_t num_threads : kThreadCounts) {
+    ResetJvmRef();
+    ASSERT_EQ(DefaultRefs<jclass>().size(), 0);
+
+    // Objects are shared so that every thread sees the same cold IDs.
+    Objects objects;
+    double seconds =
+        RunThreads(num_threads, [&objects]() { objects.CallAll(); });
+
+    if (num_threads == 1) {
+      expected_classes = DefaultRefs<jclass>().size();
+      expected_methods = method_lookups_;
+      expected_fields = field_lookups_;
+    }
+
+    // A lost or doubled push_back or lookup means a racing init.
+    EXPECT_EQ(DefaultRefs<jclass>().size(), expected_classes);
+    EXPECT_EQ(method_lookups_, expected_methods);
+    EXPECT_EQ(field_lookups_, expected_fields);
+
+    std::printf("cold,%zu,%.0f\n", num_threads,
+                num_threads * kCallsPerRound / seconds);
+  }
+
+  EXPECT_GE(expected_methods, 16);
+  EXPECT_GE(expected_fields, 8);
+}
+
+TEST_F(ScalabilityStressTest, WarmPathIsStableUnderContention) {
+  Objects objects;
+  objects.CallAll();
+
+  std::size_t expected_methods = method_lookups_;
+
+  for (std::size_t num_threads : kThreadCounts) {
+    double seconds = RunThreads(num_threads, [&objects]() {
+      for (std::size_t i = 0; i < kWarmIterations; ++i) {
+        objects.CallAll();
+      }
+    });
+
+    EXPECT_EQ(method_lookups_, expected_methods);
+
+    std::printf("warm,%zu,%.0f\n", num_threads,
+                num_threads * kWarmIterations * kCallsPerRound / seconds);
+  }
+}
+
+TEST_F(ScalabilityStressTest, ThreadGuardsAttachAndDetachConcurrently) {
+  GlobalObject<kClass0> obj{PromoteToGlobal{}, Fake<jobject>(1)};
+
+  for (std::size_t num_threads : kThreadCounts) {
+    RunThreads(num_threads, [&obj]() {
+      ThreadGuard nested_guard{};
+      obj("m0");
+    });
+  }
+}
+
+}  // namespace
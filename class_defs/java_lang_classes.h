@@ -23,6 +23,7 @@
 #include "implementation/method.h"
 #include "implementation/params.h"
 #include "implementation/return.h"
+#include "implementation/static.h"
 #include "jni_dep.h"
 
 namespace jni {
@@ -45,7 +46,7 @@ inline constexpr Class kJavaLangClassLoader{
   Method{"toString", Return{jstring{}}, Params<>{}},
 };
 
-static constexpr Class kJavaLangString{
+inline constexpr Class kJavaLangString{
   "java/lang/String",
 
   Constructor{jstring{}},
@@ -53,6 +54,18 @@ static constexpr Class kJavaLangString{
 
   Method{"toString", Return{jstring{}}, Params<>{}},
 };
+
+inline constexpr Class kJavaLangRunnable{
+  "java/lang/Runnable",
+  Method{"run", Return{}, Params{}},
+};
+
+inline constexpr Class kJavaLangSystem{
+  "java/lang/System",
+  Static{
+    Method{"identityHashCode", Return<jint>{}, Params{kJavaLangObject}},
+  },
+};
 // clang-format on
 
 }  // namespace jni
@@ -0,0 +1,65 @@
+#!/bin/bash
+
+################################################################################
+# Copyright 2021 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+################################################################################
+#
+# Prints a C++ header which embeds a compiled Java .class file as a `jbyte`
+# array, suitable for `JNIEnv::DefineClass`.
+#
+# $1 The .class file.
+# $2 The name of the array (e.g. kNativeCallbackClassBytes).
+# $3 The include guard.
+#
+# e.g. ./embed_class_file.sh Foo.class kFooClassBytes FOO_CLASS_BYTES_H_
+
+class_file=$1
+var_name=$2
+include_guard=$3
+
+if [[ -z "$class_file" || -z "$var_name" || -z "$include_guard" ]]; then
+  echo "Usage: $0 <class_file> <var_name> <include_guard>" >&2
+  exit 1
+fi
+
+cat <<HEADER
+// Generated by embed_class_file.sh from $(basename "$class_file"), do not edit.
+
+#ifndef ${include_guard}
+#define ${include_guard}
+
+#include "jni_dep.h"
+
+namespace jni {
+
+// clang-format off
+inline constexpr jbyte ${var_name}[] = {
+HEADER
+
+od -An -v -td1 "$class_file" | awk '{
+  line = "   ";
+  for (i = 1; i <= NF; ++i) { line = line " " $i ","; }
+  print line;
+}'
+
+cat <<FOOTER
+};
+// clang-format on
+
+}  // namespace jni
+
+#endif  // ${include_guard}
+FOOTER
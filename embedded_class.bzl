@@ -0,0 +1,45 @@
+"""Embeds compiled Java classes in native code.
+
+See implementation/embedded_class.h for usage from C++.
+"""
+
+def jni_bind_embedded_class(name, jar, class_name, var_name, visibility = None):
+    """Generates a cc_library whose header embeds a .class file as a jbyte array.
+
+    The header is `<package>/<name>.h` and declares `jni::<var_name>`.
+
+    Args:
+      name: Name of the cc_library (and the header).
+      jar: A java_library (or .jar) which contains the class.
+      class_name: The class's binary name, e.g. "com/foo/BulkHelper".
+      var_name: Name of the jbyte array, e.g. "kBulkHelperClassBytes".
+      visibility: Visibility of the cc_library.
+    """
+    include_guard = "JNI_BIND_EMBEDDED_{}_{}_H_".format(
+        native.package_name(),
+        name,
+    ).upper().replace("/", "_").replace("-", "_").replace(".", "_")
+    embed_class_file = str(Label("//:embed_class_file.sh"))
+
+    native.genrule(
+        name = name + "_gen",
+        srcs = [jar],
+        outs = [name + ".h"],
+        cmd = ("unzip -p $(location {jar}) {class_name}.class > $@.class && " +
+               "./$(location {tool}) $@.class {var_name} {guard} > $@ && " +
+               "rm $@.class").format(
+            jar = jar,
+            class_name = class_name,
+            tool = embed_class_file,
+            var_name = var_name,
+            guard = include_guard,
+        ),
+        tools = [embed_class_file],
+    )
+
+    native.cc_library(
+        name = name,
+        hdrs = [name + ".h"],
+        visibility = visibility,
+        deps = [str(Label("//:jni_dep"))],
+    )
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_ALLOCATE_OBJECT_H_
+#define JNI_BIND_IMPLEMENTATION_ALLOCATE_OBJECT_H_
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "implementation/class_ref.h"
+#include "implementation/default_class_loader.h"
+#include "implementation/field_ref.h"
+#include "implementation/id_type.h"
+#include "implementation/jni_helper/lifecycle.h"
+#include "implementation/jni_helper/lifecycle_object.h"
+#include "implementation/jni_type.h"
+#include "implementation/jvm.h"
+#include "implementation/local_object.h"
+#include "implementation/promotion_mechanics_tags.h"
+#include "jni_dep.h"
+
+namespace jni {
+
+// Allocates an instance of |class_v| with `AllocObject`.  No constructor is
+// run, so every field holds its default (zero) value.
+template <const auto& class_v, const auto& class_loader_v = kDefaultClassLoader,
+          const auto& jvm_v = kDefaultJvm>
+LocalObject<class_v, class_loader_v, jvm_v> AllocateUninitialized() {
+  using JniT_ = JniT<jobject, class_v, class_loader_v, jvm_v>;
+
+  return LocalObject<class_v, class_loader_v, jvm_v>{
+      AdoptLocal{},
+      LifecycleHelper<jobject, LifecycleType::LOCAL>::Allocate(
+          ClassRef_t<JniT_>::GetAndMaybeLoadClassRef(nullptr))};
+}
+
+template <typename JniT_, typename LocalObjectT, std::size_t... Is,
+          typename... Ts>
+void SetAllFields(jclass clazz, LocalObjectT& object,
+                  std::index_sequence<Is...>, Ts&&... values) {
+  (FieldRef<JniT_, IdType::FIELD, Is>{clazz, static_cast<jobject>(object)}.Set(
+       std::forward<Ts>(values)),
+   ...);
+}
+
+// Builds a plain data carrier without running its Java constructor: the
+// object is allocated with `AllocObject` and then |values| are assigned to
+// every declared field of |class_v| (in declaration order) using cached field
+// IDs, e.g.
+//
+//   static constexpr Class kPoint{"com/google/Point",
+//                                 Field{"x", jint{}}, Field{"y", jint{}}};
+//   LocalObject<kPoint> point = jni::Construct<kPoint>(1, 2);
+//
+// Only use this for classes whose constructors have no side effects beyond
+// assigning their fields (final fields included).
+template <const auto& class_v, const auto& class_loader_v = kDefaultClassLoader,
+          const auto& jvm_v = kDefaultJvm, typename... Ts>
+LocalObject<class_v, class_loader_v, jvm_v> Construct(Ts&&... values) {
+  using JniT_ = JniT<jobject, class_v, class_loader_v, jvm_v>;
+
+  static_assert(
+      sizeof...(Ts) ==
+          std::tuple_size_v<std::decay_t<decltype(class_v.fields_)>>,
+      "Construct requires a value for every declared field.");
+
+  const jclass clazz = ClassRef_t<JniT_>::GetAndMaybeLoadClassRef(nullptr);
+  LocalObject<class_v, class_loader_v, jvm_v> object{
+      AdoptLocal{}, LifecycleHelper<jobject, LifecycleType::LOCAL>::Allocate(
+                        clazz)};
+
+  SetAllFields<JniT_>(clazz, object, std::index_sequence_for<Ts...>{},
+                      std::forward<Ts>(values)...);
+
+  return object;
+}
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_ALLOCATE_OBJECT_H_
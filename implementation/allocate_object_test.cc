@@ -0,0 +1,86 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::AdoptLocal;
+using ::jni::Class;
+using ::jni::Fake;
+using ::jni::Field;
+using ::jni::LocalObject;
+using ::jni::LocalString;
+using ::jni::test::AsGlobal;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::InSequence;
+using ::testing::StrEq;
+
+static constexpr Class kPoint{
+    "kPoint",
+    Field{"x", jint{}},
+    Field{"y", jfloat{}},
+    Field{"name", jstring{}},
+};
+
+static constexpr Class kEmpty{"kEmpty"};
+
+TEST_F(JniTest, AllocateUninitialized_RunsNoConstructor) {
+  EXPECT_CALL(*env_, AllocObject(AsGlobal(Fake<jclass>())))
+      .WillOnce(testing::Return(Fake<jobject>()));
+  EXPECT_CALL(*env_, NewObjectV).Times(0);
+  EXPECT_CALL(*env_, GetMethodID).Times(0);
+
+  LocalObject<kPoint> point = jni::AllocateUninitialized<kPoint>();
+  EXPECT_EQ(static_cast<jobject>(point), Fake<jobject>());
+}
+
+TEST_F(JniTest, Construct_SetsEveryFieldInOrder) {
+  InSequence seq;
+
+  EXPECT_CALL(*env_, AllocObject).WillOnce(testing::Return(Fake<jobject>()));
+  EXPECT_CALL(*env_, GetFieldID(_, StrEq("x"), StrEq("I")));
+  EXPECT_CALL(*env_, SetIntField(Fake<jobject>(), _, 1));
+  EXPECT_CALL(*env_, GetFieldID(_, StrEq("y"), StrEq("F")));
+  EXPECT_CALL(*env_, SetFloatField(Fake<jobject>(), _, 2.f));
+  EXPECT_CALL(*env_,
+              GetFieldID(_, StrEq("name"), StrEq("Ljava/lang/String;")));
+  EXPECT_CALL(*env_, SetObjectField(Fake<jobject>(), _, Fake<jstring>()));
+
+  LocalObject<kPoint> point = jni::Construct<kPoint>(
+      1, 2.f, LocalString{AdoptLocal{}, Fake<jstring>()});
+}
+
+TEST_F(JniTest, Construct_CachesFieldIds) {
+  EXPECT_CALL(*env_, GetFieldID).Times(3);
+  EXPECT_CALL(*env_, SetIntField).Times(2);
+
+  jni::Construct<kPoint>(1, 2.f, LocalString{AdoptLocal{}, Fake<jstring>()});
+  jni::Construct<kPoint>(3, 4.f, LocalString{AdoptLocal{}, Fake<jstring>()});
+}
+
+TEST_F(JniTest, Construct_AllowsClassesWithNoFields) {
+  EXPECT_CALL(*env_, AllocObject).WillOnce(testing::Return(Fake<jobject>()));
+
+  LocalObject<kEmpty> empty = jni::Construct<kEmpty>();
+}
+
+}  // namespace
@@ -16,7 +16,13 @@
 #ifndef JNI_BIND_ARRAY_REF_H_
 #define JNI_BIND_ARRAY_REF_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <type_traits>
+#include <vector>
 
 #include "implementation/array.h"
 #include "implementation/array_view.h"
@@ -25,6 +31,7 @@
 #include "implementation/default_class_loader.h"
 #include "implementation/forward_declarations.h"
 #include "implementation/jni_helper/jni_array_helper.h"
+#include "implementation/jni_helper/jni_env.h"
 #include "implementation/jni_helper/lifecycle.h"
 #include "implementation/jni_helper/lifecycle_object.h"
 #include "implementation/jni_type.h"
@@ -61,6 +68,7 @@ class ArrayRef : public ScopedArrayImpl<JniT> {
   explicit ArrayRef(int size) : ArrayRef(static_cast<std::size_t>(size)) {}
 
   ArrayView<SpanType, JniT::kRank> Pin(bool copy_on_completion = true) {
+    Base::CheckThread("Local reference used on another thread");
     return {Base::object_ref_, copy_on_completion, Length()};
   }
 
@@ -73,7 +81,132 @@ class ArrayRef : public ScopedArrayImpl<JniT> {
     return length_.load();
   }
 
+  // Copies |size| elements from |start| into |out|, converting each with
+  // `static_cast` (e.g. `int[]` into `float`s).  Elements are moved through a
+  // small stack buffer with `Get<Type>ArrayRegion`, so there is no array sized
+  // intermediate and the conversion runs while the chunk is still in cache.
+  //
+  // Floating point values converted to integral types saturate, and NaN is 0,
+  // as in Java.  If the range is out of bounds, copying stops at the first
+  // failed chunk with `ArrayIndexOutOfBoundsException` pending.
+  template <typename U>
+  void CopyConverted(U* out, std::size_t size, std::size_t start = 0) {
+    SpanType chunk[kConversionChunkSize];
+
+    for (std::size_t i = 0; i < size; i += kConversionChunkSize) {
+      const std::size_t len = std::min(size - i, kConversionChunkSize);
+      JniArrayHelper<SpanType, 1>::GetArrayRegion(Base::object_ref_, start + i,
+                                                  len, chunk);
+      if (ExceptionPending()) {
+        return;
+      }
+      for (std::size_t j = 0; j < len; ++j) {
+        out[i + j] = Convert<U>(chunk[j]);
+      }
+    }
+  }
+
+  // Copies and converts the whole array.
+  template <typename U>
+  std::vector<U> CopyConverted() {
+    std::vector<U> ret(Length());
+    CopyConverted(ret.data(), ret.size());
+
+    return ret;
+  }
+
+  // Inverse of `CopyConverted`, writes |size| elements of |in| from |start|.
+  template <typename U>
+  void SetConverted(const U* in, std::size_t size, std::size_t start = 0) {
+    SpanType chunk[kConversionChunkSize];
+
+    for (std::size_t i = 0; i < size; i += kConversionChunkSize) {
+      const std::size_t len = std::min(size - i, kConversionChunkSize);
+      for (std::size_t j = 0; j < len; ++j) {
+        chunk[j] = Convert<SpanType>(in[i + j]);
+      }
+      JniArrayHelper<SpanType, 1>::SetArrayRegion(Base::object_ref_, start + i,
+                                                  len, chunk);
+      if (ExceptionPending()) {
+        return;
+      }
+    }
+  }
+
+  // `boolean[]` only.  Packs |size| elements from |start| into |bits|, one bit
+  // per element with element `i` in bit `i % 8` of `bits[i / 8]`.
+  void CopyPacked(std::uint8_t* bits, std::size_t size,
+                  std::size_t start = 0) {
+    static_assert(std::is_same_v<SpanType, jboolean>,
+                  "Only boolean arrays can be packed.");
+    SpanType chunk[kConversionChunkSize];
+
+    for (std::size_t i = 0; i < size; i += kConversionChunkSize) {
+      const std::size_t len = std::min(size - i, kConversionChunkSize);
+      JniArrayHelper<SpanType, 1>::GetArrayRegion(Base::object_ref_, start + i,
+                                                  len, chunk);
+      if (ExceptionPending()) {
+        return;
+      }
+      for (std::size_t j = 0; j < len; j += 8) {
+        std::uint8_t byte = 0;
+        for (std::size_t k = 0; k < 8 && j + k < len; ++k) {
+          byte |= static_cast<std::uint8_t>((chunk[j + k] != JNI_FALSE) << k);
+        }
+        bits[(i + j) / 8] = byte;
+      }
+    }
+  }
+
+  // Inverse of `CopyPacked`.
+  void SetPacked(const std::uint8_t* bits, std::size_t size,
+                 std::size_t start = 0) {
+    static_assert(std::is_same_v<SpanType, jboolean>,
+                  "Only boolean arrays can be packed.");
+    SpanType chunk[kConversionChunkSize];
+
+    for (std::size_t i = 0; i < size; i += kConversionChunkSize) {
+      const std::size_t len = std::min(size - i, kConversionChunkSize);
+      for (std::size_t j = 0; j < len; ++j) {
+        chunk[j] = (bits[(i + j) / 8] >> ((i + j) % 8)) & 1 ? JNI_TRUE
+                                                             : JNI_FALSE;
+      }
+      JniArrayHelper<SpanType, 1>::SetArrayRegion(Base::object_ref_, start + i,
+                                                  len, chunk);
+      if (ExceptionPending()) {
+        return;
+      }
+    }
+  }
+
  private:
+  // Must be a multiple of 8 (see `CopyPacked`).
+  static constexpr std::size_t kConversionChunkSize = 256;
+
+  // `static_cast` from floating point to an integral type is undefined for NaN
+  // and values out of range.
+  template <typename To, typename From>
+  static To Convert(From val) {
+    if constexpr (std::is_floating_point_v<From> && std::is_integral_v<To>) {
+      if (val != val) {
+        return 0;
+      }
+      if (val <= static_cast<From>(std::numeric_limits<To>::min())) {
+        return std::numeric_limits<To>::min();
+      }
+      if (val >= static_cast<From>(std::numeric_limits<To>::max())) {
+        return std::numeric_limits<To>::max();
+      }
+    }
+
+    return static_cast<To>(val);
+  }
+
+  // A region call with an out of bounds range throws.
+  static bool ExceptionPending() {
+    return JniEnv::GetEnv()->ExceptionCheck();
+  }
+
   std::atomic<std::size_t> length_ = kNoIdx;
 };
 
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_ARRAY_REF_VIEW_H_
+#define JNI_BIND_ARRAY_REF_VIEW_H_
+
+#include <cstddef>
+#include <utility>
+
+#include "implementation/class.h"
+#include "implementation/default_class_loader.h"
+#include "implementation/jvm.h"
+#include "implementation/local_array.h"
+#include "implementation/promotion_mechanics_tags.h"
+#include "jni_dep.h"
+
+namespace jni {
+
+// A borrowed (non-owning) array, e.g. an argument of a native method.
+//
+// Like `ObjectView`, this makes no `NewLocalRef` or `DeleteLocalRef` calls,
+// and |array| must outlive it (note this is unrelated to `ArrayView`, which is
+// pinned array memory).
+//
+// This is deliberately not a `LocalArray`, which would let a caller take
+// ownership of (and later delete) the borrowed reference.  Only the accessors
+// which leave ownership alone are exposed.
+template <typename SpanType, std::size_t kRank_ = 1,
+          const auto& class_v_ = kNoClassSpecified,
+          const auto& class_loader_v_ = kDefaultClassLoader,
+          const auto& jvm_v_ = kDefaultJvm>
+class ArrayRefView {
+ public:
+  using LocalArrayT =
+      LocalArray<SpanType, kRank_, class_v_, class_loader_v_, jvm_v_>;
+  using StorageType = typename LocalArrayT::StorageType;
+
+  ArrayRefView(StorageType array) : array_(AdoptLocal{}, array) {}
+
+  ArrayRefView(const ArrayRefView&) = delete;
+  ArrayRefView& operator=(const ArrayRefView&) = delete;
+
+  // The array is never released, only forgotten.
+  ~ArrayRefView() { array_.Release(); }
+
+  template <typename... Ts>
+  auto Pin(Ts&&... ts) {
+    return array_.Pin(std::forward<Ts>(ts)...);
+  }
+
+  std::size_t Length() { return array_.Length(); }
+
+  // Object and multi-dimensional arrays only.
+  template <typename... Ts>
+  auto Get(Ts&&... ts) {
+    return array_.Get(std::forward<Ts>(ts)...);
+  }
+
+  explicit operator StorageType() const {
+    return static_cast<StorageType>(array_);
+  }
+
+ private:
+  LocalArrayT array_;
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_ARRAY_REF_VIEW_H_
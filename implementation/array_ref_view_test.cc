@@ -0,0 +1,89 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <type_traits>
+#include <utility>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Array;
+using ::jni::ArrayRefView;
+using ::jni::ArrayView;
+using ::jni::Class;
+using ::jni::Fake;
+using ::jni::LocalArray;
+using ::jni::Method;
+using ::jni::ObjectView;
+using ::jni::Params;
+using ::jni::Return;
+using ::jni::test::JniTest;
+using ::testing::_;
+
+static constexpr Class kClass{
+    "kClass",
+    Method{"TakesArray", Return<void>{}, Params{Array<jint>{}}},
+};
+
+TEST_F(JniTest, ArrayRefView_MakesNoReferenceCalls) {
+  EXPECT_CALL(*env_, NewLocalRef).Times(0);
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jintArray>())).Times(0);
+
+  ArrayRefView<jint> arr{Fake<jintArray>()};
+  EXPECT_EQ(static_cast<jintArray>(arr), Fake<jintArray>());
+}
+
+TEST_F(JniTest, ArrayRefView_PinsTheBorrowedArray) {
+  EXPECT_CALL(*env_, GetArrayLength(Fake<jintArray>()))
+      .WillOnce(testing::Return(3));
+  EXPECT_CALL(*env_, GetIntArrayElements(Fake<jintArray>(), _));
+  EXPECT_CALL(*env_, ReleaseIntArrayElements(Fake<jintArray>(), _, 0));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jintArray>())).Times(0);
+
+  ArrayRefView<jint> arr{Fake<jintArray>()};
+  EXPECT_EQ(arr.Length(), 3);
+  ArrayView<jint> pin = arr.Pin();
+}
+
+TEST_F(JniTest, ArrayRefView_CanBePassedAsAnArgument) {
+  EXPECT_CALL(*env_, CallVoidMethodV(Fake<jobject>(), _, _));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jintArray>())).Times(0);
+
+  ObjectView<kClass> obj{Fake<jobject>()};
+  ArrayRefView<jint> arr{Fake<jintArray>()};
+  obj("TakesArray", arr);
+}
+
+// A `LocalArray` would take ownership of the borrowed array and delete it.
+static_assert(!std::is_convertible_v<ArrayRefView<jint>&&, LocalArray<jint>>);
+static_assert(
+    !std::is_constructible_v<LocalArray<jint>, ArrayRefView<jint>&&>);
+
+TEST_F(JniTest, ArrayRefView_MovedIntoAnArgumentIsNotReleased) {
+  EXPECT_CALL(*env_, CallVoidMethodV(Fake<jobject>(), _, _));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jintArray>())).Times(0);
+
+  ObjectView<kClass> obj{Fake<jobject>()};
+  ArrayRefView<jint> arr{Fake<jintArray>()};
+  obj("TakesArray", std::move(arr));
+}
+
+}  // namespace
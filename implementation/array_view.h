@@ -19,7 +19,9 @@
 #include <iterator>
 
 #include "implementation/array_type_conversion.h"
+#include "implementation/jfr_events.h"
 #include "implementation/jni_helper/jni_array_helper.h"
+#include "implementation/jni_helper/jni_check.h"
 #include "implementation/jni_helper/lifecycle.h"
 #include "jni_dep.h"
 
@@ -35,7 +37,7 @@ struct ArrayViewHelper {
 
 // Primitive Rank 1 Arrays.
 template <typename SpanType, std::size_t kRank = 1, typename Enable = void>
-class ArrayView {
+class ArrayView : JniCheckThreadOwner<>, JfrPinTimer<> {
  public:
   struct Iterator {
     using iterator_category = std::random_access_iterator_tag;
@@ -83,25 +85,40 @@ class ArrayView {
   ArrayView(ArrayView&&) = delete;
   ArrayView(const ArrayView&) = delete;
 
+  // A null |array| is an empty view (nothing is pinned).
   ArrayView(jarray array, bool copy_on_completion, std::size_t size)
       : array_(array),
         get_array_elements_result_(
-            JniArrayHelper<SpanType, kRank>::GetArrayElements(array)),
+            array == nullptr
+                ? GetArrayElementsResult<SpanType>{nullptr, JNI_FALSE}
+                : JniArrayHelper<SpanType, kRank>::GetArrayElements(array)),
         copy_on_completion_(copy_on_completion),
-        size_(size) {}
+        size_(size) {
+    ClaimThread();
+    StartPin();
+  }
 
   ~ArrayView() {
-    JniArrayHelper<SpanType, kRank>::ReleaseArrayElements(
-        array_, get_array_elements_result_.ptr_, copy_on_completion_);
+    CheckThread("ArrayView released on another thread");
+    if (array_ != nullptr) {
+      JniArrayHelper<SpanType, kRank>::ReleaseArrayElements(
+          array_, get_array_elements_result_.ptr_, copy_on_completion_);
+    }
+    EndPin("ArrayView");
   }
 
   // Arrays of rank > 1 are object arrays which are not contiguous.
-  std::enable_if_t<kRank == 1, SpanType*> ptr() {
+  //
+  // Like `std::span`, constness of the view is shallow.
+  std::enable_if_t<kRank == 1, SpanType*> ptr() const {
+    CheckThread("ArrayView used on another thread");
     return get_array_elements_result_.ptr_;
   }
 
-  Iterator begin() { return Iterator{ptr(), size_, 0}; }
-  Iterator end() { return Iterator{ptr(), size_, size_}; }
+  Iterator begin() const { return Iterator{ptr(), size_, 0}; }
+  Iterator end() const { return Iterator{ptr(), size_, size_}; }
+
+  std::size_t Size() const { return size_; }
 
  protected:
   const jarray array_;
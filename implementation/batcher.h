@@ -0,0 +1,216 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_BATCHER_H_
+#define JNI_BIND_IMPLEMENTATION_BATCHER_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "implementation/jni_helper/jni_array_helper.h"
+#include "implementation/jni_helper/jni_env.h"
+#include "implementation/jni_helper/lifecycle.h"
+#include "implementation/jni_helper/lifecycle_object.h"
+#include "jni_dep.h"
+
+namespace jni {
+
+// Coalesces many small fire-and-forget records into a single JNI crossing.
+//
+// Every record is a tuple of primitives (`Ts...`) packed as one `jlong` per
+// field into a reusable `long[]`. When the batch is full, or the oldest
+// pending record has waited `max_latency`, all pending records are copied in
+// with one `SetLongArrayRegion` and `flush` is called with the array and the
+// number of records. `flush` will typically call a bulk Java method, e.g.
+//
+//   jni::Batcher<jint, jdouble> batcher{
+//       256, std::chrono::milliseconds{5},
+//       [&](jlongArray records, jint num_records) {
+//         listener("onMetrics", records, num_records);
+//       }};
+//
+//   batcher.Add(id, value);
+//
+// Floating point fields are stored as their raw bits (decode them in Java with
+// `Float.intBitsToFloat((int) v)` and `Double.longBitsToDouble(v)`).
+//
+// There is no background thread, so deadlines are only checked in `Add` and
+// `FlushIfDue`.  If records may stop arriving, the caller must drive
+// `FlushIfDue` (e.g. from its event loop), otherwise `max_latency` is not a
+// bound and the last records wait for the next `Add` or destruction.
+//
+// A Batcher is not thread safe and must be used and destroyed on a thread
+// with a JNIEnv, destruction flushes any pending records.  Records are dropped
+// (see `Stats::dropped`) rather than flushed while an exception is pending
+// (e.g. thrown by a previous `flush`), or if the array couldn't be allocated.
+template <typename... Ts>
+class Batcher {
+ public:
+  static_assert(sizeof...(Ts) > 0, "Batcher records need at least one field.");
+  static_assert((std::is_arithmetic_v<Ts> && ...),
+                "Batcher records may only contain primitives.");
+
+  using Clock = std::chrono::steady_clock;
+  using FlushFn = std::function<void(jlongArray, jint)>;
+
+  static constexpr std::size_t kFieldsPerRecord = sizeof...(Ts);
+
+  // The array's length must fit in a `jsize`.
+  static constexpr std::size_t kMaxCapacity =
+      std::numeric_limits<jsize>::max() / kFieldsPerRecord;
+
+  struct Stats {
+    // Total records passed to `Add`.
+    std::size_t records = 0;
+    std::size_t flushes = 0;
+
+    // Flushes forced by a full batch, i.e. `Add` paid for a crossing.
+    std::size_t full_flushes = 0;
+    std::size_t deadline_flushes = 0;
+
+    // Records discarded without being flushed.
+    std::size_t dropped = 0;
+
+    // How long the oldest record of a batch waited before being flushed.
+    Clock::duration max_flush_latency{};
+    Clock::duration total_flush_latency{};
+  };
+
+  // |capacity| is in records and is clamped to [1, kMaxCapacity] (i.e. a
+  // capacity of 0 flushes every record as it is added).
+  Batcher(std::size_t capacity, Clock::duration max_latency, FlushFn flush)
+      : capacity_(std::clamp(capacity, std::size_t{1}, kMaxCapacity) *
+                  kFieldsPerRecord),
+        max_latency_(max_latency),
+        flush_(std::move(flush)),
+        records_(NewRecords(capacity_)) {
+    if (records_ != nullptr) {
+      buffer_.reserve(capacity_);
+    }
+  }
+
+  Batcher(const Batcher&) = delete;
+  Batcher& operator=(const Batcher&) = delete;
+
+  ~Batcher() {
+    Flush();
+    LifecycleHelper<jobject, LifecycleType::GLOBAL>::Delete(records_);
+  }
+
+  void Add(Ts... vals) {
+    if (buffer_.empty()) {
+      oldest_ = Clock::now();
+    }
+
+    (buffer_.push_back(ToField(vals)), ...);
+    ++stats_.records;
+
+    if (buffer_.size() >= capacity_) {
+      ++stats_.full_flushes;
+      Flush();
+    } else {
+      FlushIfDue();
+    }
+  }
+
+  // Flushes if the oldest pending record has waited `max_latency`.  Returns
+  // true if it had (whether or not the records could be flushed).
+  bool FlushIfDue() {
+    if (buffer_.empty() || Clock::now() - oldest_ < max_latency_) {
+      return false;
+    }
+
+    ++stats_.deadline_flushes;
+    Flush();
+    return true;
+  }
+
+  // Flushes all pending records (if any) regardless of the deadline.
+  void Flush() {
+    if (buffer_.empty()) {
+      return;
+    }
+
+    if (records_ == nullptr || JniEnv::GetEnv()->ExceptionCheck()) {
+      stats_.dropped += Pending();
+      buffer_.clear();
+      return;
+    }
+
+    const Clock::duration latency = Clock::now() - oldest_;
+    stats_.max_flush_latency = std::max(stats_.max_flush_latency, latency);
+    stats_.total_flush_latency += latency;
+    ++stats_.flushes;
+
+    JniArrayHelper<jlong, 1>::SetArrayRegion(records_, 0, buffer_.size(),
+                                             buffer_.data());
+    flush_(records_, static_cast<jint>(buffer_.size() / kFieldsPerRecord));
+    buffer_.clear();
+  }
+
+  // Number of records waiting for the next flush.
+  std::size_t Pending() const { return buffer_.size() / kFieldsPerRecord; }
+
+  const Stats& GetStats() const { return stats_; }
+
+ private:
+  // Returns null (with `OutOfMemoryError` pending) if allocation fails.
+  static jlongArray NewRecords(std::size_t size) {
+    jlongArray array = JniArrayHelper<jlong, 1>::NewArray(size);
+    if (array == nullptr) {
+      return nullptr;
+    }
+
+    return static_cast<jlongArray>(
+        LifecycleHelper<jobject, LifecycleType::GLOBAL>::Promote(array));
+  }
+
+  template <typename T>
+  static jlong ToField(T val) {
+    if constexpr (std::is_same_v<T, jfloat>) {
+      jint bits;
+      std::memcpy(&bits, &val, sizeof(bits));
+      return bits;
+    } else if constexpr (std::is_same_v<T, jdouble>) {
+      jlong bits;
+      std::memcpy(&bits, &val, sizeof(bits));
+      return bits;
+    } else {
+      return static_cast<jlong>(val);
+    }
+  }
+
+  // Capacity in fields (not records).
+  const std::size_t capacity_;
+  const Clock::duration max_latency_;
+  const FlushFn flush_;
+  const jlongArray records_;
+
+  std::vector<jlong> buffer_;
+  Clock::time_point oldest_;
+  Stats stats_;
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_BATCHER_H_
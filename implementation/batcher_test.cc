@@ -0,0 +1,227 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "implementation/batcher.h"
+
+#include <chrono>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Batcher;
+using ::jni::Fake;
+using ::jni::test::AsGlobal;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Return;
+
+constexpr std::chrono::hours kNoDeadline{24};
+
+TEST_F(JniTest, Batcher_AllocatesOneReusableArray) {
+  EXPECT_CALL(*env_, NewLongArray(8)).WillOnce(Return(Fake<jlongArray>()));
+  EXPECT_CALL(*env_, NewGlobalRef(Fake<jlongArray>()));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jlongArray>()));
+  EXPECT_CALL(*env_, DeleteGlobalRef(AsGlobal(Fake<jlongArray>())));
+
+  Batcher<jint, jlong> batcher{4, kNoDeadline, [](jlongArray, jint) {}};
+}
+
+TEST_F(JniTest, Batcher_ZeroCapacityFlushesEveryRecord) {
+  ON_CALL(*env_, NewLongArray).WillByDefault(Return(Fake<jlongArray>()));
+  EXPECT_CALL(*env_, NewLongArray(2));
+  EXPECT_CALL(*env_, SetLongArrayRegion(AsGlobal(Fake<jlongArray>()), 0, 2, _))
+      .Times(2);
+
+  std::vector<jint> flushed_counts;
+  Batcher<jint, jlong> batcher{
+      0, kNoDeadline,
+      [&](jlongArray, jint num_records) {
+        flushed_counts.push_back(num_records);
+      }};
+
+  batcher.Add(1, 10);
+  batcher.Add(2, 20);
+  EXPECT_EQ(batcher.Pending(), 0);
+  EXPECT_THAT(flushed_counts, ElementsAre(1, 1));
+}
+
+TEST_F(JniTest, Batcher_FlushesOnceWhenFull) {
+  ON_CALL(*env_, NewLongArray).WillByDefault(Return(Fake<jlongArray>()));
+
+  std::vector<jlong> copied;
+  EXPECT_CALL(*env_, SetLongArrayRegion(AsGlobal(Fake<jlongArray>()), 0, 6, _))
+      .WillOnce(testing::Invoke(
+          [&](jlongArray, jsize, jsize len, const jlong* buf) {
+            copied.assign(buf, buf + len);
+          }));
+
+  std::vector<jint> flushed_counts;
+  Batcher<jint, jlong> batcher{
+      3, kNoDeadline,
+      [&](jlongArray arr, jint num_records) {
+        EXPECT_EQ(arr, AsGlobal(Fake<jlongArray>()));
+        flushed_counts.push_back(num_records);
+      }};
+
+  batcher.Add(1, 10);
+  batcher.Add(2, 20);
+  EXPECT_EQ(batcher.Pending(), 2);
+  EXPECT_TRUE(flushed_counts.empty());
+
+  batcher.Add(3, 30);
+  EXPECT_EQ(batcher.Pending(), 0);
+  EXPECT_THAT(flushed_counts, ElementsAre(3));
+  EXPECT_THAT(copied, ElementsAre(1, 10, 2, 20, 3, 30));
+
+  EXPECT_EQ(batcher.GetStats().records, 3);
+  EXPECT_EQ(batcher.GetStats().flushes, 1);
+  EXPECT_EQ(batcher.GetStats().full_flushes, 1);
+  EXPECT_EQ(batcher.GetStats().deadline_flushes, 0);
+}
+
+TEST_F(JniTest, Batcher_FlushesOnDeadline) {
+  ON_CALL(*env_, NewLongArray).WillByDefault(Return(Fake<jlongArray>()));
+  EXPECT_CALL(*env_, SetLongArrayRegion(_, 0, 1, _)).Times(2);
+
+  int flushes = 0;
+  Batcher<jint> batcher{16, std::chrono::nanoseconds{0},
+                        [&](jlongArray, jint num_records) {
+                          EXPECT_EQ(num_records, 1);
+                          ++flushes;
+                        }};
+
+  batcher.Add(1);
+  batcher.Add(2);
+
+  EXPECT_EQ(flushes, 2);
+  EXPECT_EQ(batcher.GetStats().deadline_flushes, 2);
+  EXPECT_EQ(batcher.GetStats().full_flushes, 0);
+}
+
+TEST_F(JniTest, Batcher_FlushesPendingOnDestruction) {
+  ON_CALL(*env_, NewLongArray).WillByDefault(Return(Fake<jlongArray>()));
+  int flushes = 0;
+  EXPECT_CALL(*env_, SetLongArrayRegion(_, 0, 2, _));
+
+  {
+    Batcher<jint> batcher{16, kNoDeadline,
+                          [&](jlongArray, jint) { ++flushes; }};
+    batcher.Add(1);
+    batcher.Add(2);
+    EXPECT_EQ(flushes, 0);
+  }
+
+  EXPECT_EQ(flushes, 1);
+}
+
+TEST_F(JniTest, Batcher_EmptyFlushDoesNotCrossIntoJava) {
+  EXPECT_CALL(*env_, SetLongArrayRegion).Times(0);
+
+  Batcher<jint> batcher{16, kNoDeadline,
+                        [&](jlongArray, jint) { FAIL(); }};
+  batcher.Flush();
+}
+
+TEST_F(JniTest, Batcher_StoresFloatingPointAsRawBits) {
+  ON_CALL(*env_, NewLongArray).WillByDefault(Return(Fake<jlongArray>()));
+  std::vector<jlong> copied;
+  EXPECT_CALL(*env_, SetLongArrayRegion)
+      .WillOnce(testing::Invoke(
+          [&](jlongArray, jsize, jsize len, const jlong* buf) {
+            copied.assign(buf, buf + len);
+          }));
+
+  Batcher<jfloat, jdouble, jboolean> batcher{
+      1, kNoDeadline, [](jlongArray, jint) {}};
+  batcher.Add(1.f, 2.0, true);
+
+  // Bits of 1.f and 2.0 respectively.
+  EXPECT_THAT(copied, ElementsAre(0x3f800000, 0x4000000000000000, 1));
+}
+
+TEST_F(JniTest, Batcher_FlushIfDueOnlyFlushesOnceDue) {
+  ON_CALL(*env_, NewLongArray).WillByDefault(Return(Fake<jlongArray>()));
+  EXPECT_CALL(*env_, SetLongArrayRegion(_, 0, 1, _));
+
+  int flushes = 0;
+  Batcher<jint> batcher{16, std::chrono::milliseconds{20},
+                        [&](jlongArray, jint) { ++flushes; }};
+  EXPECT_FALSE(batcher.FlushIfDue());
+
+  batcher.Add(1);
+  EXPECT_FALSE(batcher.FlushIfDue());
+  EXPECT_EQ(batcher.Pending(), 1);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{30});
+  EXPECT_TRUE(batcher.FlushIfDue());
+  EXPECT_EQ(flushes, 1);
+  EXPECT_EQ(batcher.Pending(), 0);
+  EXPECT_EQ(batcher.GetStats().deadline_flushes, 1);
+}
+
+TEST_F(JniTest, Batcher_DropsRecordsIfArrayCannotBeAllocated) {
+  EXPECT_CALL(*env_, NewLongArray(16)).WillOnce(Return(nullptr));
+  EXPECT_CALL(*env_, NewGlobalRef).Times(0);
+  EXPECT_CALL(*env_, SetLongArrayRegion).Times(0);
+
+  Batcher<jint> batcher{16, kNoDeadline, [&](jlongArray, jint) { FAIL(); }};
+  batcher.Add(1);
+  batcher.Flush();
+
+  EXPECT_EQ(batcher.Pending(), 0);
+  EXPECT_EQ(batcher.GetStats().dropped, 1);
+}
+
+TEST_F(JniTest, Batcher_StopsFlushingOnceFlushThrows) {
+  ON_CALL(*env_, NewLongArray).WillByDefault(Return(Fake<jlongArray>()));
+  EXPECT_CALL(*env_, SetLongArrayRegion).Times(1);
+  EXPECT_CALL(*env_, ExceptionCheck).WillRepeatedly(Return(JNI_TRUE));
+  EXPECT_CALL(*env_, ExceptionCheck)
+      .WillOnce(Return(JNI_FALSE))
+      .RetiresOnSaturation();
+
+  int flushes = 0;
+  {
+    Batcher<jint> batcher{1, kNoDeadline,
+                          [&](jlongArray, jint) { ++flushes; }};
+    batcher.Add(1);
+    batcher.Add(2);
+    batcher.Add(3);
+
+    EXPECT_EQ(batcher.GetStats().dropped, 2);
+  }
+
+  EXPECT_EQ(flushes, 1);
+}
+
+TEST_F(JniTest, Batcher_ClampsCapacityToJsize) {
+  constexpr jsize kMaxFields = (std::numeric_limits<jsize>::max() / 2) * 2;
+  EXPECT_CALL(*env_, NewLongArray(kMaxFields)).WillOnce(Return(nullptr));
+
+  Batcher<jint, jint> batcher{std::numeric_limits<std::size_t>::max(),
+                              kNoDeadline, [](jlongArray, jint) {}};
+}
+
+}  // namespace
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_BYTE_ARRAY_FRAGMENTS_H_
+#define JNI_BIND_IMPLEMENTATION_BYTE_ARRAY_FRAGMENTS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+#include "implementation/jni_helper/jni_array_helper.h"
+#include "implementation/local_array.h"
+#include "implementation/promotion_mechanics_tags.h"
+#include "jni_dep.h"
+
+namespace jni {
+
+// True if |Fragment| is a contiguous range of bytes.
+template <typename Fragment>
+constexpr bool kIsByteFragment =
+    sizeof(*std::data(std::declval<Fragment&>())) == 1;
+
+// Scatter-gather transfer between a chain of native buffers and one `byte[]`.
+//
+// |fragments| is any range whose elements have byte sized `std::data` and
+// `std::size` (e.g. `std::string_view`, `std::vector<char>`, `std::array`).
+// A `byte[]` of the fragments' total size is allocated, and each fragment is
+// copied in with its own `SetByteArrayRegion`, so the chain is never flattened
+// into an intermediate buffer, e.g.
+//
+//   jni::LocalArray<jbyte> payload = jni::ToByteArray({header, body});
+//   obj("send", payload);
+//
+// Returns a null array if the total size does not fit in a `jsize` (nothing is
+// allocated), or if the allocation fails (`OutOfMemoryError` is pending).
+template <typename Fragments>
+LocalArray<jbyte> ToByteArray(const Fragments& fragments) {
+  constexpr std::size_t kMaxSize = std::numeric_limits<jsize>::max();
+
+  std::size_t size = 0;
+  bool overflow = false;
+  for (const auto& fragment : fragments) {
+    static_assert(kIsByteFragment<decltype(fragment)>,
+                  "Fragments must be byte sized.");
+    overflow |= std::size(fragment) > kMaxSize - std::min(size, kMaxSize);
+    size += std::size(fragment);
+  }
+
+  jbyteArray array =
+      overflow ? nullptr : JniArrayHelper<jbyte, 1>::NewArray(size);
+  if (array == nullptr) {
+    return {AdoptLocal{}, array};
+  }
+
+  std::size_t offset = 0;
+  for (const auto& fragment : fragments) {
+    const std::size_t len = std::size(fragment);
+    if (len != 0) {
+      JniArrayHelper<jbyte, 1>::SetArrayRegion(
+          array, offset, len,
+          reinterpret_cast<const jbyte*>(std::data(fragment)));
+      offset += len;
+    }
+  }
+
+  return {AdoptLocal{}, array};
+}
+
+inline LocalArray<jbyte> ToByteArray(
+    std::initializer_list<std::string_view> fragments) {
+  return ToByteArray<std::initializer_list<std::string_view>>(fragments);
+}
+
+// The gather half of `ToByteArray`, fills each of |fragments| in turn from
+// |array| (starting at |offset|) with its own `GetByteArrayRegion`. Copying
+// stops at the end of |array| (a trailing fragment may be partially filled).
+// Returns the number of bytes copied.
+template <typename Fragments>
+std::size_t ReadInto(jbyteArray array, Fragments&& fragments,
+                     std::size_t offset = 0) {
+  const std::size_t length = JniArrayHelper<jbyte, 1>::GetLength(array);
+
+  std::size_t copied = 0;
+  for (auto& fragment : fragments) {
+    static_assert(kIsByteFragment<decltype(fragment)>,
+                  "Fragments must be byte sized.");
+    if (offset >= length) {
+      break;
+    }
+
+    const std::size_t len = std::min(std::size(fragment), length - offset);
+    if (len != 0) {
+      JniArrayHelper<jbyte, 1>::GetArrayRegion(
+          array, offset, len, reinterpret_cast<jbyte*>(std::data(fragment)));
+      offset += len;
+      copied += len;
+    }
+  }
+
+  return copied;
+}
+
+template <typename T, typename Fragments>
+std::size_t ReadInto(const T& array, Fragments&& fragments,
+                     std::size_t offset = 0) {
+  return ReadInto(static_cast<jbyteArray>(array),
+                  std::forward<Fragments>(fragments), offset);
+}
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_BYTE_ARRAY_FRAGMENTS_H_
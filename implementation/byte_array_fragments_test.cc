@@ -0,0 +1,114 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Fake;
+using ::jni::LocalArray;
+using ::jni::ReadInto;
+using ::jni::ToByteArray;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::InSequence;
+using ::testing::Return;
+
+TEST_F(JniTest, ToByteArray_AllocatesOnceAndSetsEachFragment) {
+  const std::string header = "head";
+  const std::vector<char> body(10);
+
+  InSequence seq;
+  EXPECT_CALL(*env_, NewByteArray(14)).WillOnce(Return(Fake<jbyteArray>()));
+  EXPECT_CALL(*env_, SetByteArrayRegion(Fake<jbyteArray>(), 0, 4, _));
+  EXPECT_CALL(*env_, SetByteArrayRegion(Fake<jbyteArray>(), 4, 10, _));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jbyteArray>()));
+
+  LocalArray<jbyte> array = ToByteArray(
+      {header, std::string_view{body.data(), body.size()}, std::string_view{}});
+}
+
+TEST_F(JniTest, ToByteArray_AcceptsContainersOfFragments) {
+  const std::vector<std::string_view> fragments{"ab", "cde"};
+
+  EXPECT_CALL(*env_, NewByteArray(5)).WillOnce(Return(Fake<jbyteArray>()));
+  EXPECT_CALL(*env_, SetByteArrayRegion(Fake<jbyteArray>(), 0, 2, _));
+  EXPECT_CALL(*env_, SetByteArrayRegion(Fake<jbyteArray>(), 2, 3, _));
+
+  ToByteArray(fragments);
+}
+
+// Claims a size without backing storage, the bytes are never read.
+struct OversizedFragment {
+  const char* data() const { return nullptr; }
+  std::size_t size() const { return std::numeric_limits<jsize>::max(); }
+};
+
+TEST_F(JniTest, ToByteArray_ReturnsNullWhenTotalSizeOverflows) {
+  const std::array<OversizedFragment, 2> fragments{};
+
+  EXPECT_CALL(*env_, NewByteArray).Times(0);
+  EXPECT_CALL(*env_, SetByteArrayRegion).Times(0);
+
+  LocalArray<jbyte> array = ToByteArray(fragments);
+  EXPECT_EQ(static_cast<jbyteArray>(array), nullptr);
+}
+
+TEST_F(JniTest, ToByteArray_ReturnsNullWhenAllocationFails) {
+  EXPECT_CALL(*env_, NewByteArray(5)).WillOnce(Return(nullptr));
+  EXPECT_CALL(*env_, SetByteArrayRegion).Times(0);
+
+  LocalArray<jbyte> array = ToByteArray({"ab", "cde"});
+  EXPECT_EQ(static_cast<jbyteArray>(array), nullptr);
+}
+
+TEST_F(JniTest, ReadInto_FillsFragmentsUntilArrayEnds) {
+  std::vector<std::array<char, 4>> fragments(3);
+
+  EXPECT_CALL(*env_, GetArrayLength(Fake<jbyteArray>())).WillOnce(Return(7));
+  EXPECT_CALL(*env_, GetByteArrayRegion(Fake<jbyteArray>(), 1, 4, _));
+  EXPECT_CALL(*env_, GetByteArrayRegion(Fake<jbyteArray>(), 5, 2, _));
+
+  EXPECT_EQ(ReadInto(Fake<jbyteArray>(), fragments, 1), std::size_t{6});
+}
+
+TEST_F(JniTest, ReadInto_AcceptsLocalArray) {
+  std::vector<std::string> fragments{std::string(2, '\0')};
+
+  EXPECT_CALL(*env_, GetArrayLength(Fake<jbyteArray>())).WillOnce(Return(2));
+  EXPECT_CALL(*env_, GetByteArrayRegion(Fake<jbyteArray>(), 0, 2, _))
+      .WillOnce([](jbyteArray, jsize, jsize, jbyte* buf) {
+        buf[0] = 'h';
+        buf[1] = 'i';
+      });
+
+  LocalArray<jbyte> array{jni::AdoptLocal{}, Fake<jbyteArray>()};
+  EXPECT_EQ(ReadInto(array, fragments), std::size_t{2});
+  EXPECT_EQ(fragments[0], "hi");
+}
+
+}  // namespace
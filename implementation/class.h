@@ -34,7 +34,7 @@
 
 namespace jni {
 
-static constexpr struct NoClass {
+inline constexpr struct NoClass {
   const char* name_ = "__JNI_BIND__NO_CLASS__";
   const Static<std::tuple<>, std::tuple<>> static_{};
   const std::tuple<> methods_{};
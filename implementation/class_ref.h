@@ -35,7 +35,7 @@
 
 namespace jni {
 
-static inline jclass LoadClassFromObject(const char* name, jobject object_ref);
+inline jclass LoadClassFromObject(const char* name, jobject object_ref);
 
 // Represents a a jclass instance for a specific class. 4 flavours exist:
 //   1) Default JVM, default class loader.
@@ -122,7 +122,7 @@ class ClassRef {
 // for the subclass instead of the original class. However, the original class
 // should still be loadable from the subclass's class loader, so we load the
 // ClassRef explicitly by class name.
-static inline jclass LoadClassFromObject(const char* name, jobject object_ref) {
+inline jclass LoadClassFromObject(const char* name, jobject object_ref) {
   // We cannot refer to the wrapper MethodRefs here, so we just manually use
   // the class loader through JNI.
 
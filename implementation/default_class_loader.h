@@ -105,14 +105,14 @@ class NullClassLoader {
   }
 };
 
-static constexpr NullClassLoader kNullClassLoader;
-static constexpr DefaultClassLoader kDefaultClassLoader;
+inline constexpr NullClassLoader kNullClassLoader;
+inline constexpr DefaultClassLoader kDefaultClassLoader;
 
 // DO NOT USE: This obviates a compiler bug for value based enablement on ctor.
-static constexpr auto kShadowNullClassLoader = kNullClassLoader;
+inline constexpr auto kShadowNullClassLoader = kNullClassLoader;
 
 // DO NOT USE: This obviates a compiler bug for value based enablement on ctor.
-static constexpr auto kShadowDefaultClassLoader = kDefaultClassLoader;
+inline constexpr auto kShadowDefaultClassLoader = kDefaultClassLoader;
 
 }  // namespace jni
 
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_EMBEDDED_CLASS_H_
+#define JNI_BIND_IMPLEMENTATION_EMBEDDED_CLASS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "implementation/default_class_loader.h"
+#include "implementation/jni_helper/invoke_static.h"
+#include "implementation/jni_helper/jni_env.h"
+#include "implementation/jni_helper/jni_helper.h"
+#include "implementation/jni_helper/lifecycle.h"
+#include "implementation/jni_helper/lifecycle_object.h"
+#include "jni_dep.h"
+
+namespace jni {
+
+// A Java class whose bytecode is embedded in native code and defined with
+// `DefineClass` when `JvmRef` is built, so that it needn't be on the classpath
+// (see `jni_bind_embedded_class` in //:embedded_class.bzl).
+//
+// Once defined, the class is used through its normal `Class` definition:
+//
+//   #include "foo/bulk_helper_class_bytes.h"
+//
+//   inline constexpr jni::Class kBulkHelper{"com/foo/BulkHelper", ...};
+//   inline const jni::EmbeddedClass kBulkHelperEmbedded{
+//       kBulkHelper, jni::kBulkHelperClassBytes};
+//
+//   jni::StaticRef<kBulkHelper>{}("packFields", ...);
+//
+// Classes are defined into the system class loader (`kDefaultClassLoader`) or
+// the bootstrap loader (`kNullClassLoader`).  Embedded classes must be declared
+// at namespace scope (i.e. before `JvmRef` is built).  Android does not
+// support `DefineClass`.
+class EmbeddedClass {
+ public:
+  template <typename ClassT, std::size_t N,
+            typename ClassLoaderT = DefaultClassLoader>
+  EmbeddedClass(const ClassT& class_def, const jbyte (&bytes)[N],
+                const ClassLoaderT& = kDefaultClassLoader)
+      : name_(class_def.name_),
+        bytes_(bytes),
+        size_(static_cast<jsize>(N)),
+        use_bootstrap_loader_(std::is_same_v<ClassLoaderT, NullClassLoader>) {
+    static_assert(std::is_same_v<ClassLoaderT, DefaultClassLoader> ||
+                      std::is_same_v<ClassLoaderT, NullClassLoader>,
+                  "Embedded classes can only be defined into "
+                  "kDefaultClassLoader or kNullClassLoader.");
+
+    Registry().push_back(this);
+  }
+
+  EmbeddedClass(const EmbeddedClass&) = delete;
+  EmbeddedClass(EmbeddedClass&&) = delete;
+
+  // Defines every embedded class (called when `JvmRef` is built).  Classes
+  // which are already defined (e.g. `JvmRef` was rebuilt) are skipped.  Any
+  // other failure (e.g. `ClassFormatError`, or a missing superclass) is
+  // described to stderr and leaves the class undefined (see `Defined`).
+  //
+  // Returns true if every embedded class is defined.
+  static bool DefineAll() {
+    if (Registry().empty()) {
+      return true;
+    }
+
+    bool all_defined = true;
+    jobject system_class_loader = GetSystemClassLoader();
+    for (const EmbeddedClass* embedded_class : Registry()) {
+      jclass clazz = Define(
+          embedded_class->name_,
+          embedded_class->use_bootstrap_loader_ ? nullptr : system_class_loader,
+          embedded_class->bytes_, embedded_class->size_);
+
+      if (clazz != nullptr) {
+        LifecycleHelper<jclass, LifecycleType::LOCAL>::Delete(clazz);
+      } else {
+        JniEnv::GetEnv()->ExceptionDescribe();
+      }
+
+      embedded_class->defined_.store(clazz != nullptr);
+      all_defined &= clazz != nullptr;
+    }
+    LifecycleHelper<jobject, LifecycleType::LOCAL>::Delete(system_class_loader);
+
+    return all_defined;
+  }
+
+  // Defines |name| from |bytes| into |class_loader| (null for the bootstrap
+  // loader) and returns it as a local.  If the class was already defined (e.g.
+  // by another library in this process), the existing class is returned.
+  // Otherwise returns null with the `DefineClass` exception pending.
+  //
+  // Duplicate definitions are `LinkageError`s, but so are genuinely bad class
+  // files (e.g. `ClassFormatError`), so only a `LinkageError` for a class that
+  // can then be found is treated as a duplicate.
+  static jclass Define(const char* name, jobject class_loader,
+                       const jbyte* bytes, jsize size) {
+    jclass clazz = JniHelper::DefineClass(name, class_loader, bytes, size);
+    if (clazz != nullptr) {
+      return clazz;
+    }
+
+    JNIEnv* env = JniEnv::GetEnv();
+    jthrowable error = env->ExceptionOccurred();
+    env->ExceptionClear();
+
+    if (IsLinkageError(error)) {
+      clazz = JniHelper::FindClass(name);
+    }
+
+    if (clazz == nullptr) {
+      env->ExceptionClear();
+      env->Throw(error);
+    }
+    LifecycleHelper<jobject, LifecycleType::LOCAL>::Delete(error);
+
+    return clazz;
+  }
+
+  // True once the class has been defined (or found already defined).
+  bool Defined() const { return defined_.load(); }
+
+  const char* name_;
+  const jbyte* bytes_;
+  const jsize size_;
+  const bool use_bootstrap_loader_;
+
+ private:
+  static bool IsLinkageError(jthrowable error) {
+    jclass linkage_error = JniHelper::FindClass("java/lang/LinkageError");
+    if (linkage_error == nullptr) {
+      JniEnv::GetEnv()->ExceptionClear();
+      return false;
+    }
+
+    const bool ret = JniEnv::GetEnv()->IsInstanceOf(error, linkage_error);
+    LifecycleHelper<jclass, LifecycleType::LOCAL>::Delete(linkage_error);
+
+    return ret;
+  }
+
+  mutable std::atomic<bool> defined_{false};
+
+  static std::vector<const EmbeddedClass*>& Registry() {
+    static auto* registry = new std::vector<const EmbeddedClass*>{};
+    return *registry;
+  }
+
+  // Returns a local.
+  static jobject GetSystemClassLoader() {
+    jclass class_loader_class = JniHelper::FindClass("java/lang/ClassLoader");
+    jmethodID get_system_class_loader =
+        JniHelper::GetStaticMethodID(class_loader_class, "getSystemClassLoader",
+                                     "()Ljava/lang/ClassLoader;");
+    jobject system_class_loader = InvokeHelper<jobject, 0, true>::Invoke(
+        nullptr, class_loader_class, get_system_class_loader);
+    LifecycleHelper<jclass, LifecycleType::LOCAL>::Delete(class_loader_class);
+
+    return system_class_loader;
+  }
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_EMBEDDED_CLASS_H_
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Class;
+using ::jni::EmbeddedClass;
+using ::jni::Fake;
+using ::jni::JvmRef;
+using ::jni::kDefaultJvm;
+using ::jni::kNullClassLoader;
+using ::jni::test::JniTestWithNoDefaultJvmRef;
+using ::testing::_;
+using ::testing::Return;
+using ::testing::StrEq;
+
+// Not a valid class file, the mock never parses it.
+inline constexpr jbyte kBytes[] = {-54, -2, -70, -66};
+
+inline constexpr Class kClass{"com/jnibind/test/EmbeddedClass"};
+inline const EmbeddedClass kEmbeddedClass{kClass, kBytes};
+
+inline constexpr Class kBootstrapClass{"com/jnibind/test/EmbeddedBootstrap"};
+inline const EmbeddedClass kEmbeddedBootstrapClass{kBootstrapClass, kBytes,
+                                                   kNullClassLoader};
+
+TEST_F(JniTestWithNoDefaultJvmRef, EmbeddedClass_DefinedOnJvmRefStartup) {
+  ON_CALL(*env_, CallStaticObjectMethodV)
+      .WillByDefault(Return(Fake<jobject>()));
+  EXPECT_CALL(*env_, DeleteLocalRef).Times(testing::AnyNumber());
+
+  EXPECT_CALL(*env_, FindClass(StrEq("java/lang/ClassLoader")));
+  EXPECT_CALL(*env_,
+              GetStaticMethodID(_, StrEq("getSystemClassLoader"),
+                                StrEq("()Ljava/lang/ClassLoader;")));
+  EXPECT_CALL(*env_, DefineClass(StrEq("com/jnibind/test/EmbeddedClass"),
+                                 Fake<jobject>(), &kBytes[0], 4))
+      .WillOnce(Return(Fake<jclass>(1)));
+  EXPECT_CALL(*env_, DefineClass(StrEq("com/jnibind/test/EmbeddedBootstrap"),
+                                 nullptr, &kBytes[0], 4))
+      .WillOnce(Return(Fake<jclass>(2)));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jclass>(1)));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jclass>(2)));
+
+  JvmRef<kDefaultJvm> jvm_ref{jvm_.get()};
+}
+
+TEST_F(JniTestWithNoDefaultJvmRef, EmbeddedClass_AlreadyDefinedIsSkipped) {
+  EXPECT_CALL(*env_, DefineClass).Times(2).WillRepeatedly(Return(nullptr));
+  EXPECT_CALL(*env_, ExceptionOccurred)
+      .WillRepeatedly(Return(static_cast<jthrowable>(Fake<jobject>(7))));
+  EXPECT_CALL(*env_, FindClass(StrEq("java/lang/LinkageError"))).Times(2);
+  EXPECT_CALL(*env_, IsInstanceOf).WillRepeatedly(Return(JNI_TRUE));
+  EXPECT_CALL(*env_, FindClass(StrEq("com/jnibind/test/EmbeddedClass")));
+  EXPECT_CALL(*env_, FindClass(StrEq("com/jnibind/test/EmbeddedBootstrap")));
+  EXPECT_CALL(*env_, FindClass(StrEq("java/lang/ClassLoader")));
+  EXPECT_CALL(*env_, ExceptionClear).Times(2);
+  EXPECT_CALL(*env_, ExceptionDescribe).Times(0);
+
+  JvmRef<kDefaultJvm> jvm_ref{jvm_.get()};
+
+  EXPECT_TRUE(kEmbeddedClass.Defined());
+  EXPECT_TRUE(kEmbeddedBootstrapClass.Defined());
+}
+
+TEST_F(JniTestWithNoDefaultJvmRef, EmbeddedClass_BadClassIsReported) {
+  const jthrowable error = static_cast<jthrowable>(Fake<jobject>(7));
+
+  EXPECT_CALL(*env_, DefineClass).Times(2).WillRepeatedly(Return(nullptr));
+  EXPECT_CALL(*env_, ExceptionOccurred).WillRepeatedly(Return(error));
+  EXPECT_CALL(*env_, FindClass(StrEq("java/lang/ClassLoader")));
+  EXPECT_CALL(*env_, FindClass(StrEq("java/lang/LinkageError"))).Times(2);
+  EXPECT_CALL(*env_, IsInstanceOf).WillRepeatedly(Return(JNI_TRUE));
+  EXPECT_CALL(*env_, FindClass(StrEq("com/jnibind/test/EmbeddedClass")))
+      .WillOnce(Return(nullptr));
+  EXPECT_CALL(*env_, FindClass(StrEq("com/jnibind/test/EmbeddedBootstrap")))
+      .WillOnce(Return(nullptr));
+  EXPECT_CALL(*env_, Throw(error)).Times(2);
+  EXPECT_CALL(*env_, ExceptionDescribe).Times(2);
+
+  JvmRef<kDefaultJvm> jvm_ref{jvm_.get()};
+
+  EXPECT_FALSE(kEmbeddedClass.Defined());
+  EXPECT_FALSE(kEmbeddedBootstrapClass.Defined());
+}
+
+// e.g. `OutOfMemoryError`, the class mustn't be looked up.
+TEST_F(JniTestWithNoDefaultJvmRef, EmbeddedClass_OnlyLinkageErrorsAreLookedUp) {
+  const jthrowable error = static_cast<jthrowable>(Fake<jobject>(7));
+
+  EXPECT_CALL(*env_, DefineClass).Times(2).WillRepeatedly(Return(nullptr));
+  EXPECT_CALL(*env_, ExceptionOccurred).WillRepeatedly(Return(error));
+  EXPECT_CALL(*env_, FindClass(StrEq("java/lang/ClassLoader")));
+  EXPECT_CALL(*env_, FindClass(StrEq("java/lang/LinkageError"))).Times(2);
+  EXPECT_CALL(*env_, IsInstanceOf(error, _))
+      .WillRepeatedly(Return(JNI_FALSE));
+  EXPECT_CALL(*env_, FindClass(StrEq("com/jnibind/test/EmbeddedClass")))
+      .Times(0);
+  EXPECT_CALL(*env_, FindClass(StrEq("com/jnibind/test/EmbeddedBootstrap")))
+      .Times(0);
+  EXPECT_CALL(*env_, Throw(error)).Times(2);
+  EXPECT_CALL(*env_, ExceptionDescribe).Times(2);
+
+  JvmRef<kDefaultJvm> jvm_ref{jvm_.get()};
+
+  EXPECT_FALSE(kEmbeddedClass.Defined());
+  EXPECT_FALSE(kEmbeddedBootstrapClass.Defined());
+}
+
+}  // namespace
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_ENUM_H_
+#define JNI_BIND_IMPLEMENTATION_ENUM_H_
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "implementation/class_ref.h"
+#include "implementation/default_class_loader.h"
+#include "implementation/field_ref.h"
+#include "implementation/jni_helper/field_value.h"
+#include "implementation/jni_helper/invoke_static.h"
+#include "implementation/jni_helper/jni_array_helper.h"
+#include "implementation/jni_helper/jni_helper.h"
+#include "implementation/jni_helper/lifecycle.h"
+#include "implementation/jni_helper/lifecycle_object.h"
+#include "implementation/jni_type.h"
+#include "implementation/jvm.h"
+#include "implementation/name_constants.h"
+#include "implementation/object_view.h"
+#include "implementation/ref_storage.h"
+#include "jni_dep.h"
+#include "metaprogramming/double_locked_value.h"
+#include "metaprogramming/epoch_locked_value.h"
+#include "metaprogramming/string_concatenate.h"
+
+namespace jni {
+
+// Maps the Java enum |class_v| to the C++ enum |CppEnum|, whose values must be
+// the Java ordinals (i.e. declared in the same order starting from 0), e.g.
+//
+//   static constexpr Class kColor{"com/google/Color"};
+//   enum class Color { kRed, kGreen, kBlue };
+//   using ColorEnum = jni::Enum<kColor, Color>;
+//
+//   Color color = ColorEnum::ToNative(java_color);
+//   obj("setColor", ColorEnum::ToJava(Color::kBlue));
+//
+// `values()` is called once per `JvmRef` and its constants are held as
+// globals indexed by ordinal.  Ordinals are read directly from the `ordinal`
+// field (with a cached field ID), so both directions are O(1) and make no
+// Java calls.
+template <const auto& class_v, typename CppEnum,
+          const auto& class_loader_v = kDefaultClassLoader,
+          const auto& jvm_v = kDefaultJvm>
+class Enum {
+ public:
+  static_assert(std::is_enum_v<CppEnum>, "CppEnum must be an enum.");
+
+  using JniT_ = JniT<jobject, class_v, class_loader_v, jvm_v>;
+
+  static constexpr std::string_view kValuesPrefix{"()[L"};
+  static constexpr std::string_view kValuesSignature =
+      metaprogramming::StringConcatenate_v<
+          kValuesPrefix, NameOrNothing<class_v>::val,
+          metaprogramming::Constants::semi_colon>;
+
+  // |java_enum| must be a non-null constant of |class_v|.
+  static CppEnum ToNative(jobject java_enum) {
+    return static_cast<CppEnum>(FieldHelper<jint, 0, false>::GetValue(
+        java_enum, GetOrdinalFieldID()));
+  }
+
+  template <typename T>
+  static CppEnum ToNative(const T& java_enum) {
+    return ToNative(static_cast<jobject>(java_enum));
+  }
+
+  // The constant is a global held until `JvmRef` is torn down, so the view
+  // may be used beyond the current native call.  Null if out of range.
+  static ObjectView<class_v, class_loader_v, jvm_v> ToJava(CppEnum value) {
+    const std::vector<jobject>& values = Values();
+    const auto ordinal = static_cast<std::size_t>(value);
+
+    return {ordinal < values.size() ? values[ordinal] : nullptr};
+  }
+
+  // Number of constants in the Java enum.
+  static std::size_t Size() { return Values().size(); }
+
+ private:
+  // See JvmRef::~JvmRef.
+  static void Reset() {
+    values_.Reset([](std::vector<jobject>* values) {
+      for (jobject value : *values) {
+        LifecycleHelper<jobject, LifecycleType::GLOBAL>::Delete(value);
+      }
+      delete values;
+    });
+  }
+
+  static jclass GetClass() {
+    return ClassRef_t<JniT_>::GetAndMaybeLoadClassRef(nullptr);
+  }
+
+  static jfieldID GetOrdinalFieldID() {
+    return ordinal_field_.LoadAndMaybeInit(JvmEpoch::Get(), []() {
+      // `ordinal` is declared by `java.lang.Enum`.
+      return JniHelper::GetFieldID(GetClass(), "ordinal", "I");
+    });
+  }
+
+  static const std::vector<jobject>& Values() {
+    return *values_.LoadAndMaybeInit([]() {
+      GetCachedConstantResetList().push_back(&Enum::Reset);
+
+      const jclass clazz = GetClass();
+      const jobjectArray array =
+          static_cast<jobjectArray>(InvokeHelper<jobject, 0, true>::Invoke(
+              nullptr, clazz,
+              JniHelper::GetStaticMethodID(clazz, "values",
+                                           kValuesSignature.data())));
+
+      auto* values = new std::vector<jobject>(
+          JniArrayHelper<jobject, 1>::GetLength(array));
+      for (std::size_t i = 0; i < values->size(); ++i) {
+        (*values)[i] = LifecycleHelper<jobject, LifecycleType::GLOBAL>::Promote(
+            JniArrayHelper<jobject, 1>::GetArrayElement(array, i));
+      }
+      LifecycleHelper<jobject, LifecycleType::LOCAL>::Delete(array);
+
+      return values;
+    });
+  }
+
+  static inline metaprogramming::DoubleLockedValue<std::vector<jobject>*>
+      values_;
+  static inline metaprogramming::EpochLockedValue<jfieldID> ordinal_field_;
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_ENUM_H_
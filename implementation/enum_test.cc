@@ -0,0 +1,99 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Class;
+using ::jni::Enum;
+using ::jni::Fake;
+using ::jni::test::AsGlobal;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::StrEq;
+
+static constexpr Class kColor{"com/google/Color"};
+
+enum class Color { kRed, kGreen, kBlue };
+
+using ColorEnum = Enum<kColor, Color>;
+
+class EnumTest : public JniTest {
+ public:
+  void SetUp() override {
+    JniTest::SetUp();
+
+    ON_CALL(*env_, CallStaticObjectMethodV)
+        .WillByDefault(testing::Return(Fake<jobjectArray>()));
+    ON_CALL(*env_, GetArrayLength(Fake<jobjectArray>()))
+        .WillByDefault(testing::Return(3));
+    ON_CALL(*env_, GetObjectArrayElement(Fake<jobjectArray>(), _))
+        .WillByDefault([](jobjectArray, jsize idx) {
+          return Fake<jobject>(idx + 1);
+        });
+
+    EXPECT_CALL(*env_, DeleteGlobalRef).Times(AnyNumber());
+  }
+};
+
+TEST_F(EnumTest, ReadsValuesOnce) {
+  EXPECT_CALL(*env_, GetStaticMethodID(_, StrEq("values"),
+                                       StrEq("()[Lcom/google/Color;")))
+      .WillOnce(testing::Return(Fake<jmethodID>()));
+  EXPECT_CALL(*env_, CallStaticObjectMethodV).Times(1);
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jobjectArray>()));
+
+  EXPECT_EQ(ColorEnum::Size(), std::size_t{3});
+  EXPECT_EQ(static_cast<jobject>(ColorEnum::ToJava(Color::kRed)),
+            AsGlobal(Fake<jobject>(1)));
+  EXPECT_EQ(static_cast<jobject>(ColorEnum::ToJava(Color::kBlue)),
+            AsGlobal(Fake<jobject>(3)));
+}
+
+TEST_F(EnumTest, ReleasesValuesWithJvmRef) {
+  EXPECT_CALL(*env_, DeleteGlobalRef(AsGlobal(Fake<jobject>(1))));
+  EXPECT_CALL(*env_, DeleteGlobalRef(AsGlobal(Fake<jobject>(2))));
+  EXPECT_CALL(*env_, DeleteGlobalRef(AsGlobal(Fake<jobject>(3))));
+
+  ColorEnum::ToJava(Color::kGreen);
+}
+
+TEST_F(EnumTest, OutOfRangeValuesAreNull) {
+  EXPECT_EQ(static_cast<jobject>(ColorEnum::ToJava(static_cast<Color>(3))),
+            nullptr);
+}
+
+TEST_F(EnumTest, ToNativeReadsTheOrdinalField) {
+  EXPECT_CALL(*env_, GetFieldID(_, StrEq("ordinal"), StrEq("I")))
+      .WillOnce(testing::Return(Fake<jfieldID>()));
+  EXPECT_CALL(*env_, GetIntField(Fake<jobject>(), Fake<jfieldID>()))
+      .WillOnce(testing::Return(1))
+      .WillOnce(testing::Return(2));
+  EXPECT_CALL(*env_, CallIntMethodV).Times(0);
+
+  EXPECT_EQ(ColorEnum::ToNative(Fake<jobject>()), Color::kGreen);
+  EXPECT_EQ(ColorEnum::ToNative(Fake<jobject>()), Color::kBlue);
+}
+
+}  // namespace
@@ -25,6 +25,13 @@ namespace jni {
 
 struct FieldBase {};
 
+// Tags a static field as `static final`, e.g.
+//   Static{Field{"MAX_BATCH", Final{}, jint{}}}
+//
+// Primitive and String constants are then read once per `JvmRef` and served
+// from a native cache afterwards (see `FieldRef`).  Final fields can't be set.
+struct Final {};
+
 template <typename Raw_>
 struct Field : public FieldBase {
  public:
@@ -34,14 +41,21 @@ struct Field : public FieldBase {
 
   const Raw_ raw_ = {};
 
+  const bool final_ = false;
+
   constexpr Field(const char* name) : name_(name) {}
   constexpr Field(const char* name, Raw_ value_raw)
       : name_(name), raw_(value_raw) {}
+  constexpr Field(const char* name, Final, Raw_ value_raw)
+      : name_(name), raw_(value_raw), final_(true) {}
 };
 
 template <typename Raw_>
 Field(const char*, Raw_) -> Field<Raw_>;
 
+template <typename Raw_>
+Field(const char*, Final, Raw_) -> Field<Raw_>;
+
 template <typename T>
 using Raw_t = typename T::Raw;
 
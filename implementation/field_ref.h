@@ -20,7 +20,9 @@
 #include <mutex>
 #include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "implementation/class_ref.h"
 #include "implementation/field_selection.h"
@@ -28,22 +30,27 @@
 #include "implementation/id_type.h"
 #include "implementation/jni_helper/field_value.h"
 #include "implementation/jni_helper/jni_helper.h"
+#include "implementation/jni_helper/lifecycle.h"
+#include "implementation/jni_helper/lifecycle_object.h"
+#include "implementation/jni_helper/out_of_line_helpers.h"
 #include "implementation/jni_helper/static_field_value.h"
 #include "implementation/promotion_mechanics_tags.h"
 #include "implementation/proxy.h"
 #include "implementation/proxy_convenience_aliases.h"
 #include "implementation/ref_base.h"
+#include "implementation/ref_storage.h"
 #include "jni_dep.h"
 #include "metaprogramming/double_locked_value.h"
+#include "metaprogramming/epoch_locked_value.h"
 #include "metaprogramming/optional_wrap.h"
 #include "metaprogramming/queryable_map.h"
 
 namespace jni {
 
+// Resets cached Java constants, e.g. `Final` static fields or `Enum` values.
 // See JvmRef::~JvmRef.
-static inline auto& GetDefaultLoadedFieldList() {
-  static auto* ret_val =
-      new std::vector<metaprogramming::DoubleLockedValue<jfieldID>*>{};
+inline auto& GetCachedConstantResetList() {
+  static auto* ret_val = new TeardownList<void (*)()>{};
   return *ret_val;
 }
 
@@ -64,15 +71,11 @@ class FieldRef {
   FieldRef(const FieldRef&&) = delete;
   void operator=(const FieldRef&) = delete;
 
-  // This method is thread safe.
+  // This method is thread safe. Field IDs are cached against the `JvmEpoch`.
   static jfieldID GetFieldID(jclass clazz) {
-    static jni::metaprogramming::DoubleLockedValue<jfieldID> return_value;
-
-    return return_value.LoadAndMaybeInit([=]() {
-      if constexpr (JniT::class_loader_v == kDefaultClassLoader) {
-        GetDefaultLoadedFieldList().push_back(&return_value);
-      }
+    static jni::metaprogramming::EpochLockedValue<jfieldID> return_value;
 
+    return return_value.LoadAndMaybeInit(JvmEpoch::Get(), [=]() {
       if constexpr (IdT::kIsStatic) {
         return jni::JniHelper::GetStaticFieldID(clazz, IdT::Name(),
                                                 Signature_v<IdT>.data());
@@ -84,6 +87,31 @@ class FieldRef {
   }
 
   using ReturnProxied = Return_t<typename IdT::MaterializeCDeclT, IdT>;
+  using CDecl = CDecl_t<typename IdT::RawValT>;
+
+  // `Final` static primitives and Strings are only read once per `JvmRef`.
+  // Like field IDs, this is limited to the default class loader.
+  static constexpr bool kIsCachedConstant =
+      IdT::kIsStatic && IdT::kIsFinal && IdT::kRank == 0 &&
+      JniT::class_loader_v == kDefaultClassLoader &&
+      (!std::is_base_of_v<RefBaseBase, ReturnProxied> ||
+       std::is_same_v<CDecl, jstring>);
+
+  // Constants are boxed so that 0 (or a null String, held as a global) isn't
+  // mistaken for an empty cache.
+  using CachedT = std::conditional_t<std::is_same_v<CDecl, jstring>, jobject*,
+                                     CDecl*>;
+
+  static void ResetCachedConstant() {
+    cached_constant_.Reset([](CachedT cached) {
+      if constexpr (std::is_same_v<CDecl, jstring>) {
+        if (*cached != nullptr) {
+          LifecycleHelper<jobject, LifecycleType::GLOBAL>::Delete(*cached);
+        }
+      }
+      delete cached;
+    });
+  }
 
   const auto& SelfVal() {
     if constexpr (IdT::kIsStatic) {
@@ -94,27 +122,65 @@ class FieldRef {
   }
 
   ReturnProxied Get() {
-    if constexpr (std::is_base_of_v<RefBaseBase, ReturnProxied>) {
+    if constexpr (kIsCachedConstant) {
+      return GetCachedConstant();
+    } else if constexpr (std::is_base_of_v<RefBaseBase, ReturnProxied>) {
       return {AdoptLocal{},
-              FieldHelper<CDecl_t<typename IdT::RawValT>, IdT::kRank,
-                          IdT::kIsStatic>::GetValue(SelfVal(),
-                                                    GetFieldID(class_ref_))};
+              FieldDispatch<CDecl_t<typename IdT::RawValT>, IdT::kRank,
+                            IdT::kIsStatic>::GetValue(SelfVal(),
+                                                      GetFieldID(class_ref_))};
     } else {
-      return {FieldHelper<CDecl_t<typename IdT::RawValT>, IdT::kRank,
-                          IdT::kIsStatic>::GetValue(SelfVal(),
-                                                    GetFieldID(class_ref_))};
+      return {FieldDispatch<CDecl_t<typename IdT::RawValT>, IdT::kRank,
+                            IdT::kIsStatic>::GetValue(SelfVal(),
+                                                      GetFieldID(class_ref_))};
     }
   }
 
   template <typename T>
   void Set(T&& value) {
-    FieldHelper<CDecl_t<typename IdT::RawValT>, IdT::kRank,
-                IdT::kIsStatic>::SetValue(SelfVal(), GetFieldID(class_ref_),
-                                          Proxy_t<T>::ProxyAsArg(
-                                              std::forward<T>(value)));
+    static_assert(!IdT::kIsFinal, "Final fields cannot be set.");
+
+    FieldDispatch<CDecl_t<typename IdT::RawValT>, IdT::kRank,
+                  IdT::kIsStatic>::SetValue(SelfVal(), GetFieldID(class_ref_),
+                                            Proxy_t<T>::ProxyAsArg(
+                                                std::forward<T>(value)));
   }
 
  private:
+  ReturnProxied GetCachedConstant() {
+    const CachedT cached = cached_constant_.LoadAndMaybeInit([this]() {
+      GetCachedConstantResetList().push_back(&FieldRef::ResetCachedConstant);
+
+      CDecl value = FieldHelper<CDecl, 0, true>::GetValue(
+          class_ref_, GetFieldID(class_ref_));
+
+      if constexpr (std::is_same_v<CDecl, jstring>) {
+        return new jobject{
+            value == nullptr
+                ? nullptr
+                : LifecycleHelper<jobject, LifecycleType::GLOBAL>::Promote(
+                      value)};
+      } else {
+        return new CDecl{value};
+      }
+    });
+
+    if constexpr (std::is_same_v<CDecl, jstring>) {
+      if (*cached == nullptr) {
+        return {AdoptLocal{}, static_cast<jstring>(nullptr)};
+      }
+
+      return {AdoptLocal{},
+              static_cast<jstring>(
+                  LifecycleHelper<jobject, LifecycleType::LOCAL>::NewReference(
+                      *cached))};
+    } else {
+      return {*cached};
+    }
+  }
+
+  static inline metaprogramming::DoubleLockedValue<CachedT> cached_constant_;
+
   const jclass class_ref_;
   const jobject object_ref_;
 };
@@ -54,15 +54,23 @@ class LocalObject;
 template <const auto& class_v_, const auto& class_loader_v_, const auto& jvm_v_>
 class GlobalObject;
 
+template <const auto& class_v_, const auto& class_loader_v_, const auto& jvm_v_>
+class ObjectView;
+
 // Strings.
 class LocalString;
 class GlobalString;
+class StringView;
 
 // Arrays.
 template <typename SpanType, std::size_t kRank_, const auto& class_v_,
           const auto& class_loader_v_, const auto& jvm_v_>
 class LocalArray;
 
+template <typename SpanType, std::size_t kRank_, const auto& class_v_,
+          const auto& class_loader_v_, const auto& jvm_v_>
+class ArrayRefView;
+
 // Classloaders.
 template <LifecycleType lifecycleType, const auto& jvm_v_,
           const auto& class_loader_v_>
@@ -59,6 +59,37 @@ struct Id {
                                     kIdType == IdType::STATIC_OVERLOAD_PARAM ||
                                     kIdType == IdType::STATIC_FIELD;
 
+  // True for methods tagged `Nonvirtual` (see method.h).  Static methods may
+  // not be tagged, but are reported so `OverloadRef` can reject them.
+  static constexpr bool IsNonvirtual() {
+    if constexpr ((kIdType == IdType::OVERLOAD_SET ||
+                   kIdType == IdType::OVERLOAD ||
+                   kIdType == IdType::OVERLOAD_PARAM) &&
+                  idx != kNoIdx) {
+      return std::get<idx>(Class().methods_).nonvirtual_;
+    } else if constexpr ((kIdType == IdType::STATIC_OVERLOAD_SET ||
+                          kIdType == IdType::STATIC_OVERLOAD ||
+                          kIdType == IdType::STATIC_OVERLOAD_PARAM) &&
+                         idx != kNoIdx) {
+      return std::get<idx>(Class().static_.methods_).nonvirtual_;
+    } else {
+      return false;
+    }
+  }
+
+  static constexpr bool kIsNonvirtual = IsNonvirtual();
+
+  // True for static fields tagged `Final` (see field.h).
+  static constexpr bool IsFinal() {
+    if constexpr (kIdType == IdType::STATIC_FIELD && idx != kNoIdx) {
+      return std::get<idx>(Class().static_.fields_).final_;
+    } else {
+      return false;
+    }
+  }
+
+  static constexpr bool kIsFinal = IsFinal();
+
   template <IdType new_id_type>
   using ChangeIdType = Id<JniT, new_id_type, idx, secondary_idx, tertiary_idx>;
 
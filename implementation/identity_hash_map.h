@@ -0,0 +1,210 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_IDENTITY_HASH_MAP_H_
+#define JNI_BIND_IMPLEMENTATION_IDENTITY_HASH_MAP_H_
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "class_defs/java_lang_classes.h"
+#include "implementation/jni_helper/jni_array_helper.h"
+#include "implementation/jni_helper/jni_helper.h"
+#include "implementation/jni_helper/lifecycle.h"
+#include "implementation/static_ref.h"
+#include "jni_dep.h"
+
+namespace jni {
+
+// Native map keyed by Java object identity (i.e. `==` in Java, not `equals`).
+//
+// jobjects can't be compared by handle (two locals to one object differ), so
+// keys are bucketed by `System.identityHashCode`, which is fetched once per
+// key and stored with the entry.  `IsSameObject` is only called for keys
+// whose identity hashes collide, e.g.
+//
+//   jni::IdentityHashMap<kJavaLangObject, int> counts;
+//   ++counts.Insert(obj, 0);
+//   int* count = counts.Find(other_local_to_obj);
+//
+// Keys are held as globals or, if |kWeak|, weak globals (which don't keep the
+// key alive; see `PurgeCollected`).  Keys must be non-null.  Like any
+// reference, the map must not outlive the `JvmRef`, and is not thread safe.
+template <const auto& class_v, typename V, bool kWeak = false>
+class IdentityHashMap {
+ public:
+  IdentityHashMap() = default;
+  IdentityHashMap(const IdentityHashMap&) = delete;
+  IdentityHashMap& operator=(const IdentityHashMap&) = delete;
+
+  ~IdentityHashMap() { Clear(); }
+
+  // Returns the value for |key|, inserting |value| if it is absent.
+  V& Insert(jobject key, V value = V{}) {
+    const jint hash = IdentityHash(key);
+
+    if (auto it = FindIn(hash, key); it != entries_.end()) {
+      return it->second.second;
+    }
+
+    return entries_.emplace(hash, std::make_pair(NewKey(key), std::move(value)))
+        ->second.second;
+  }
+
+  // Inserts or replaces the value for |key|.
+  V& InsertOrAssign(jobject key, V value) {
+    const jint hash = IdentityHash(key);
+
+    if (auto it = FindIn(hash, key); it != entries_.end()) {
+      return it->second.second = std::move(value);
+    }
+
+    return entries_.emplace(hash, std::make_pair(NewKey(key), std::move(value)))
+        ->second.second;
+  }
+
+  // Null if |key| is absent.
+  V* Find(jobject key) { return Find(IdentityHash(key), key); }
+
+  // Looks up every element of |keys| (null elements are never present).  The
+  // result is in array order and each element's local is released as it goes.
+  std::vector<V*> FindAll(jobjectArray keys) {
+    std::vector<V*> ret(JniArrayHelper<jobject, 1>::GetLength(keys), nullptr);
+
+    for (std::size_t i = 0; i < ret.size(); ++i) {
+      jobject key = JniArrayHelper<jobject, 1>::GetArrayElement(keys, i);
+
+      if (key != nullptr) {
+        ret[i] = Find(key);
+        LifecycleHelper<jobject, LifecycleType::LOCAL>::Delete(key);
+      }
+    }
+
+    return ret;
+  }
+
+  // Returns true if |key| was present.
+  bool Erase(jobject key) {
+    auto it = FindIn(IdentityHash(key), key);
+
+    if (it == entries_.end()) {
+      return false;
+    }
+
+    DeleteKey(it->second.first);
+    entries_.erase(it);
+
+    return true;
+  }
+
+  // Drops entries whose keys have been collected.  Only for weak maps.
+  std::size_t PurgeCollected() {
+    static_assert(kWeak, "Global keys are never collected.");
+
+    std::size_t purged = 0;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (JniHelper::IsSameObject(it->second.first, nullptr)) {
+        DeleteKey(it->second.first);
+        it = entries_.erase(it);
+        ++purged;
+      } else {
+        ++it;
+      }
+    }
+
+    return purged;
+  }
+
+  void Clear() {
+    for (auto& [hash, entry] : entries_) {
+      DeleteKey(entry.first);
+    }
+
+    entries_.clear();
+  }
+
+  std::size_t Size() const { return entries_.size(); }
+
+  template <typename T>
+  V& Insert(const T& key, V value = V{}) {
+    return Insert(static_cast<jobject>(key), std::move(value));
+  }
+
+  template <typename T>
+  V& InsertOrAssign(const T& key, V value) {
+    return InsertOrAssign(static_cast<jobject>(key), std::move(value));
+  }
+
+  template <typename T>
+  V* Find(const T& key) {
+    return Find(static_cast<jobject>(key));
+  }
+
+  template <typename T>
+  bool Erase(const T& key) {
+    return Erase(static_cast<jobject>(key));
+  }
+
+ private:
+  // Entries are (key ref, value), keyed by the key's identity hash.
+  using Entries = std::unordered_multimap<jint, std::pair<jobject, V>>;
+
+  static jint IdentityHash(jobject key) {
+    return StaticRef<kJavaLangSystem>{}("identityHashCode", key);
+  }
+
+  static jobject NewKey(jobject key) {
+    if constexpr (kWeak) {
+      return JniHelper::NewWeakGlobalRef(key);
+    } else {
+      return LifecycleHelper<jobject, LifecycleType::GLOBAL>::NewReference(key);
+    }
+  }
+
+  static void DeleteKey(jobject key) {
+    if constexpr (kWeak) {
+      JniHelper::DeleteWeakGlobalRef(key);
+    } else {
+      LifecycleHelper<jobject, LifecycleType::GLOBAL>::Delete(key);
+    }
+  }
+
+  typename Entries::iterator FindIn(jint hash, jobject key) {
+    auto [begin, end] = entries_.equal_range(hash);
+
+    for (auto it = begin; it != end; ++it) {
+      if (JniHelper::IsSameObject(it->second.first, key)) {
+        return it;
+      }
+    }
+
+    return entries_.end();
+  }
+
+  V* Find(jint hash, jobject key) {
+    auto it = FindIn(hash, key);
+
+    return it == entries_.end() ? nullptr : &it->second.second;
+  }
+
+  Entries entries_;
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_IDENTITY_HASH_MAP_H_
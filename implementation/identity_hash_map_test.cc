@@ -0,0 +1,136 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Fake;
+using ::jni::IdentityHashMap;
+using ::jni::kJavaLangObject;
+using ::jni::test::AsGlobal;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::IsNull;
+using ::testing::Pointee;
+using ::testing::Return;
+using ::testing::StrEq;
+
+class IdentityHashMapTest : public JniTest {
+ public:
+  void SetUp() override {
+    JniTest::SetUp();
+
+    ON_CALL(*env_, GetStaticMethodID(_, StrEq("identityHashCode"),
+                                     StrEq("(Ljava/lang/Object;)I")))
+        .WillByDefault(Return(Fake<jmethodID>()));
+  }
+};
+
+TEST_F(IdentityHashMapTest, ComparesObjectsOnlyWhenHashesCollide) {
+  EXPECT_CALL(*env_, CallStaticIntMethodV)
+      .WillOnce(Return(1))
+      .WillOnce(Return(2))
+      .WillOnce(Return(1));
+  EXPECT_CALL(*env_, IsSameObject(AsGlobal(Fake<jobject>(1)), Fake<jobject>(3)))
+      .WillOnce(Return(JNI_TRUE));
+  EXPECT_CALL(*env_, IsSameObject(AsGlobal(Fake<jobject>(2)), _)).Times(0);
+  EXPECT_CALL(*env_, DeleteGlobalRef(AsGlobal(Fake<jobject>(1))));
+  EXPECT_CALL(*env_, DeleteGlobalRef(AsGlobal(Fake<jobject>(2))));
+
+  IdentityHashMap<kJavaLangObject, int> map;
+  map.Insert(Fake<jobject>(1), 10);
+  map.Insert(Fake<jobject>(2), 20);
+
+  // A different local to the first object.
+  EXPECT_THAT(map.Find(Fake<jobject>(3)), Pointee(10));
+  EXPECT_EQ(map.Size(), std::size_t{2});
+}
+
+TEST_F(IdentityHashMapTest, MissesWithoutComparingOnDistinctHash) {
+  EXPECT_CALL(*env_, CallStaticIntMethodV)
+      .WillOnce(Return(1))
+      .WillOnce(Return(2));
+  EXPECT_CALL(*env_, IsSameObject).Times(0);
+  EXPECT_CALL(*env_, DeleteGlobalRef(AsGlobal(Fake<jobject>(1))));
+
+  IdentityHashMap<kJavaLangObject, int> map;
+  map.Insert(Fake<jobject>(1), 10);
+
+  EXPECT_THAT(map.Find(Fake<jobject>(2)), IsNull());
+}
+
+TEST_F(IdentityHashMapTest, InsertOrAssignReplacesAndEraseReleases) {
+  ON_CALL(*env_, CallStaticIntMethodV).WillByDefault(Return(1));
+  ON_CALL(*env_, IsSameObject(AsGlobal(Fake<jobject>(1)), Fake<jobject>(1)))
+      .WillByDefault(Return(JNI_TRUE));
+  EXPECT_CALL(*env_, NewGlobalRef(Fake<jobject>(1))).Times(1);
+  EXPECT_CALL(*env_, DeleteGlobalRef(AsGlobal(Fake<jobject>(1))));
+
+  IdentityHashMap<kJavaLangObject, int> map;
+  map.Insert(Fake<jobject>(1), 10);
+  map.InsertOrAssign(Fake<jobject>(1), 20);
+  EXPECT_THAT(map.Find(Fake<jobject>(1)), Pointee(20));
+
+  EXPECT_TRUE(map.Erase(Fake<jobject>(1)));
+  EXPECT_FALSE(map.Erase(Fake<jobject>(1)));
+  EXPECT_EQ(map.Size(), std::size_t{0});
+}
+
+TEST_F(IdentityHashMapTest, FindAllReleasesEachElement) {
+  ON_CALL(*env_, GetArrayLength(Fake<jobjectArray>())).WillByDefault(Return(3));
+  ON_CALL(*env_, GetObjectArrayElement(Fake<jobjectArray>(), _))
+      .WillByDefault([](jobjectArray, jsize idx) {
+        return idx == 2 ? nullptr : Fake<jobject>(idx + 1);
+      });
+  ON_CALL(*env_, CallStaticIntMethodV).WillByDefault(Return(1));
+  ON_CALL(*env_, IsSameObject(AsGlobal(Fake<jobject>(1)), Fake<jobject>(1)))
+      .WillByDefault(Return(JNI_TRUE));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jobject>(1)));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jobject>(2)));
+  EXPECT_CALL(*env_, DeleteGlobalRef(AsGlobal(Fake<jobject>(1))));
+
+  IdentityHashMap<kJavaLangObject, int> map;
+  map.Insert(Fake<jobject>(1), 10);
+
+  EXPECT_THAT(map.FindAll(Fake<jobjectArray>()),
+              ElementsAre(Pointee(10), IsNull(), IsNull()));
+}
+
+TEST_F(IdentityHashMapTest, WeakMapPurgesCollectedKeys) {
+  ON_CALL(*env_, CallStaticIntMethodV).WillByDefault(Return(1));
+  EXPECT_CALL(*env_, NewWeakGlobalRef(Fake<jobject>(1)))
+      .WillOnce(Return(Fake<jobject>(2)));
+  EXPECT_CALL(*env_, IsSameObject(Fake<jobject>(2), nullptr))
+      .WillOnce(Return(JNI_TRUE));
+  EXPECT_CALL(*env_, DeleteWeakGlobalRef(Fake<jobject>(2)));
+  EXPECT_CALL(*env_, NewGlobalRef(Fake<jobject>(1))).Times(0);
+
+  IdentityHashMap<kJavaLangObject, int, true> map;
+  map.Insert(Fake<jobject>(1), 10);
+
+  EXPECT_EQ(map.PurgeCollected(), std::size_t{1});
+  EXPECT_EQ(map.Size(), std::size_t{0});
+}
+
+}  // namespace
@@ -0,0 +1,214 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_JAVA_STREAM_H_
+#define JNI_BIND_IMPLEMENTATION_JAVA_STREAM_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
+#include "class_defs/java_io_classes.h"
+#include "implementation/byte_array_fragments.h"
+#include "implementation/global_object.h"
+#include "implementation/jni_helper/jni_array_helper.h"
+#include "implementation/jni_helper/jni_env.h"
+#include "implementation/jni_helper/lifecycle.h"
+#include "implementation/promotion_mechanics_tags.h"
+#include "jni_dep.h"
+
+namespace jni {
+
+// Transfer buffers are reused for every call, so a stream costs one `byte[]`
+// allocation however much is moved through it.
+inline constexpr std::size_t kDefaultJavaStreamBufferSize = 64 * 1024;
+
+// Shared transfer buffer for `JavaInputStreamReader` and
+// `JavaOutputStreamWriter`. Held as a global so the adapters may outlive the
+// native call they were built in.
+//
+// |size| is clamped to the largest `jsize`, as chunk lengths are passed to
+// Java as `int`s.  A zero |size| is rejected (no array is allocated), as is a
+// failed allocation. `Array` is then null and the adapters transfer nothing.
+class JavaStreamBuffer {
+ public:
+  static constexpr std::size_t kMaxSize = std::numeric_limits<jsize>::max();
+
+  explicit JavaStreamBuffer(std::size_t size)
+      : size_(std::min(size, kMaxSize)),
+        array_(size_ == 0 ? nullptr : Allocate(size_)) {}
+
+  JavaStreamBuffer(const JavaStreamBuffer&) = delete;
+  JavaStreamBuffer& operator=(const JavaStreamBuffer&) = delete;
+
+  ~JavaStreamBuffer() {
+    if (array_ != nullptr) {
+      LifecycleHelper<jbyteArray, LifecycleType::GLOBAL>::Delete(array_);
+    }
+  }
+
+  std::size_t Size() const { return size_; }
+  jbyteArray Array() const { return array_; }
+
+ private:
+  static jbyteArray Allocate(std::size_t size) {
+    const jbyteArray local = JniArrayHelper<jbyte, 1>::NewArray(size);
+    if (local == nullptr) {
+      return nullptr;
+    }
+
+    return LifecycleHelper<jbyteArray, LifecycleType::GLOBAL>::Promote(local);
+  }
+
+  const std::size_t size_;
+  const jbyteArray array_;
+};
+
+// Reads a `java.io.InputStream` into native memory, e.g.
+//
+//   jni::JavaInputStreamReader reader{input_stream};
+//   std::size_t read = reader.Read(buffer.data(), buffer.size());
+//
+// Every chunk is one `read(byte[], int, int)` into the transfer buffer and one
+// `GetByteArrayRegion` out of it (no `Pin`, and no array per call).  Java
+// exceptions (e.g. `IOException`) end the read and are left pending.  Not
+// thread safe.
+class JavaInputStreamReader {
+ public:
+  explicit JavaInputStreamReader(
+      jobject stream, std::size_t buffer_size = kDefaultJavaStreamBufferSize)
+      : stream_(NewRef{}, stream), buffer_(buffer_size) {}
+
+  template <typename T>
+  explicit JavaInputStreamReader(
+      const T& stream, std::size_t buffer_size = kDefaultJavaStreamBufferSize)
+      : JavaInputStreamReader(static_cast<jobject>(stream), buffer_size) {}
+
+  // Reads until |size| bytes have been copied into |data| or the stream ends.
+  // Returns the number of bytes read, which is less than |size| only at the
+  // end of the stream.
+  std::size_t Read(void* data, std::size_t size) {
+    auto* out = static_cast<jbyte*>(data);
+
+    std::size_t total = 0;
+    if (buffer_.Array() == nullptr) {
+      return total;
+    }
+
+    while (total < size) {
+      const auto len =
+          static_cast<jint>(std::min(size - total, buffer_.Size()));
+      const jint read = stream_("read", buffer_.Array(), jint{0}, len);
+
+      // -1 signals the end of the stream.
+      if (read <= 0 || JniEnv::GetEnv()->ExceptionCheck()) {
+        break;
+      }
+
+      JniArrayHelper<jbyte, 1>::GetArrayRegion(buffer_.Array(), 0, read,
+                                               out + total);
+      total += read;
+    }
+
+    return total;
+  }
+
+  // Fills |fragment| (see `ReadInto`).
+  template <typename Fragment>
+  std::size_t Read(Fragment& fragment) {
+    static_assert(kIsByteFragment<Fragment>, "Fragments must be byte sized.");
+    return Read(std::data(fragment), std::size(fragment));
+  }
+
+ private:
+  GlobalObject<kJavaIoInputStream> stream_;
+  JavaStreamBuffer buffer_;
+};
+
+// Writes native memory to a `java.io.OutputStream`, e.g.
+//
+//   jni::JavaOutputStreamWriter writer{output_stream};
+//   writer.Write(payload.data(), payload.size());
+//   writer.Flush();
+//
+// Every chunk is one `SetByteArrayRegion` into the transfer buffer and one
+// `write(byte[], int, int)`.  Java exceptions (e.g. `IOException`) end the
+// write and are left pending.  Not thread safe.
+class JavaOutputStreamWriter {
+ public:
+  explicit JavaOutputStreamWriter(
+      jobject stream, std::size_t buffer_size = kDefaultJavaStreamBufferSize)
+      : stream_(NewRef{}, stream), buffer_(buffer_size) {}
+
+  template <typename T>
+  explicit JavaOutputStreamWriter(
+      const T& stream, std::size_t buffer_size = kDefaultJavaStreamBufferSize)
+      : JavaOutputStreamWriter(static_cast<jobject>(stream), buffer_size) {}
+
+  // Writes all |size| bytes of |data|. Returns false if the buffer is
+  // unusable or `write` threw, in which case the rest is not written.
+  bool Write(const void* data, std::size_t size) {
+    const auto* in = static_cast<const jbyte*>(data);
+
+    if (buffer_.Array() == nullptr) {
+      return false;
+    }
+
+    while (size > 0) {
+      const std::size_t len = std::min(size, buffer_.Size());
+
+      JniArrayHelper<jbyte, 1>::SetArrayRegion(buffer_.Array(), 0, len, in);
+      stream_("write", buffer_.Array(), jint{0}, static_cast<jint>(len));
+
+      // No further JNI calls may be made with the exception pending.
+      if (JniEnv::GetEnv()->ExceptionCheck()) {
+        return false;
+      }
+
+      in += len;
+      size -= len;
+    }
+
+    return true;
+  }
+
+  template <typename Fragment>
+  bool Write(const Fragment& fragment) {
+    static_assert(kIsByteFragment<const Fragment>,
+                  "Fragments must be byte sized.");
+    return Write(std::data(fragment), std::size(fragment));
+  }
+
+  // Returns false if `flush` threw, or isn't called because an exception is
+  // already pending (e.g. from a failed `Write`).
+  bool Flush() {
+    if (JniEnv::GetEnv()->ExceptionCheck()) {
+      return false;
+    }
+
+    stream_("flush");
+    return !JniEnv::GetEnv()->ExceptionCheck();
+  }
+
+ private:
+  GlobalObject<kJavaIoOutputStream> stream_;
+  JavaStreamBuffer buffer_;
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_JAVA_STREAM_H_
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Fake;
+using ::jni::JavaInputStreamReader;
+using ::jni::JavaOutputStreamWriter;
+using ::jni::test::AsGlobal;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+using ::testing::Return;
+using ::testing::StrEq;
+
+class JavaStreamTest : public JniTest {
+ public:
+  void SetUp() override {
+    JniTest::SetUp();
+
+    ON_CALL(*env_, NewByteArray).WillByDefault(Return(Fake<jbyteArray>()));
+    EXPECT_CALL(*env_, DeleteGlobalRef).Times(AnyNumber());
+  }
+
+  static jbyteArray Buffer() {
+    return static_cast<jbyteArray>(AsGlobal(Fake<jbyteArray>()));
+  }
+};
+
+TEST_F(JavaStreamTest, ReaderReusesOneBufferUntilEndOfStream) {
+  EXPECT_CALL(*env_, NewByteArray(4)).Times(1);
+  EXPECT_CALL(*env_, GetMethodID(_, StrEq("read"), StrEq("([BII)I")));
+  EXPECT_CALL(*env_, CallIntMethodV)
+      .WillOnce(Return(4))
+      .WillOnce(Return(3))
+      .WillOnce(Return(-1));
+  EXPECT_CALL(*env_, GetByteArrayRegion(Buffer(), 0, 4, _));
+  EXPECT_CALL(*env_, GetByteArrayRegion(Buffer(), 0, 3, _));
+
+  JavaInputStreamReader reader{Fake<jobject>(), 4};
+  std::array<char, 10> out;
+
+  EXPECT_EQ(reader.Read(out), std::size_t{7});
+}
+
+TEST_F(JavaStreamTest, ReaderStopsWhenDestinationIsFull) {
+  EXPECT_CALL(*env_, CallIntMethodV).WillOnce(Return(5));
+  EXPECT_CALL(*env_, GetByteArrayRegion(Buffer(), 0, 5, _))
+      .WillOnce([](jbyteArray, jsize, jsize len, jbyte* buf) {
+        std::fill(buf, buf + len, 'a');
+      });
+
+  JavaInputStreamReader reader{Fake<jobject>(), 8};
+  std::string out(5, '\0');
+
+  EXPECT_EQ(reader.Read(out.data(), out.size()), std::size_t{5});
+  EXPECT_EQ(out, "aaaaa");
+}
+
+TEST_F(JavaStreamTest, WriterChunksThroughBuffer) {
+  InSequence seq;
+  EXPECT_CALL(*env_, NewByteArray(4));
+  EXPECT_CALL(*env_, SetByteArrayRegion(Buffer(), 0, 4, _));
+  EXPECT_CALL(*env_, CallVoidMethodV);
+  EXPECT_CALL(*env_, SetByteArrayRegion(Buffer(), 0, 4, _));
+  EXPECT_CALL(*env_, CallVoidMethodV);
+  EXPECT_CALL(*env_, SetByteArrayRegion(Buffer(), 0, 2, _));
+  EXPECT_CALL(*env_, CallVoidMethodV);
+  EXPECT_CALL(*env_, CallVoidMethodV);
+
+  JavaOutputStreamWriter writer{Fake<jobject>(), 4};
+  writer.Write(std::string(10, 'a'));
+  writer.Flush();
+}
+
+TEST_F(JavaStreamTest, WriterStopsWhenWriteThrows) {
+  EXPECT_CALL(*env_, SetByteArrayRegion(Buffer(), 0, 4, _)).Times(1);
+  EXPECT_CALL(*env_, CallVoidMethodV).Times(1);
+  EXPECT_CALL(*env_, ExceptionCheck).WillRepeatedly(Return(true));
+
+  JavaOutputStreamWriter writer{Fake<jobject>(), 4};
+  EXPECT_FALSE(writer.Write(std::string(10, 'a')));
+}
+
+TEST_F(JavaStreamTest, WriterDoesNotFlushWithExceptionPending) {
+  EXPECT_CALL(*env_, CallVoidMethodV).Times(1);
+  EXPECT_CALL(*env_, ExceptionCheck).WillRepeatedly(Return(true));
+
+  JavaOutputStreamWriter writer{Fake<jobject>(), 4};
+  EXPECT_FALSE(writer.Write(std::string(4, 'a')));
+  EXPECT_FALSE(writer.Flush());
+}
+
+TEST_F(JavaStreamTest, ClampsBufferSizeToJsize) {
+  constexpr jsize kMax = std::numeric_limits<jsize>::max();
+  EXPECT_CALL(*env_, NewByteArray(kMax)).WillOnce(Return(Fake<jbyteArray>()));
+  EXPECT_CALL(*env_, SetByteArrayRegion(Buffer(), 0, 16, _));
+  EXPECT_CALL(*env_, CallVoidMethodV);
+
+  JavaOutputStreamWriter writer{Fake<jobject>(),
+                                std::numeric_limits<std::size_t>::max()};
+  EXPECT_TRUE(writer.Write(std::string(16, 'a')));
+}
+
+TEST_F(JavaStreamTest, ReaderStopsWhenReadThrows) {
+  EXPECT_CALL(*env_, CallIntMethodV).WillOnce(Return(4));
+  EXPECT_CALL(*env_, ExceptionCheck).WillRepeatedly(Return(true));
+  EXPECT_CALL(*env_, GetByteArrayRegion).Times(0);
+
+  JavaInputStreamReader reader{Fake<jobject>(), 4};
+  std::array<char, 10> out;
+
+  EXPECT_EQ(reader.Read(out), std::size_t{0});
+}
+
+TEST_F(JavaStreamTest, RejectsZeroBufferSize) {
+  EXPECT_CALL(*env_, NewByteArray).Times(0);
+  EXPECT_CALL(*env_, CallIntMethodV).Times(0);
+  EXPECT_CALL(*env_, CallVoidMethodV).Times(0);
+
+  JavaInputStreamReader reader{Fake<jobject>(), 0};
+  std::array<char, 10> out;
+  EXPECT_EQ(reader.Read(out), std::size_t{0});
+
+  JavaOutputStreamWriter writer{Fake<jobject>(), 0};
+  EXPECT_FALSE(writer.Write(std::string(10, 'a')));
+}
+
+TEST_F(JavaStreamTest, ReleasesStreamAndBuffer) {
+  EXPECT_CALL(*env_, DeleteGlobalRef(AsGlobal(Fake<jobject>())));
+  EXPECT_CALL(*env_, DeleteGlobalRef(Buffer()));
+
+  JavaInputStreamReader reader{Fake<jobject>()};
+}
+
+}  // namespace
@@ -0,0 +1,321 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef JNI_BIND_IMPLEMENTATION_JFR_EVENTS_H_
+#define JNI_BIND_IMPLEMENTATION_JFR_EVENTS_H_
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "implementation/embedded_class.h"
+#include "implementation/jni_helper/invoke.h"
+#include "implementation/jni_helper/invoke_static.h"
+#include "implementation/jni_helper/jni_env.h"
+#include "implementation/jni_helper/jni_helper.h"
+#include "implementation/jni_helper/lifecycle.h"
+#include "implementation/jni_helper/lifecycle_object.h"
+#include "implementation/jni_helper/lifecycle_string.h"
+#include "implementation/ref_storage.h"
+#include "java/com/jnibind/jni_bind_event_class_bytes.h"
+#include "jni_dep.h"
+#include "metaprogramming/double_locked_value.h"
+#include "metaprogramming/epoch_locked_value.h"
+
+namespace jni {
+
+// Defines `com.jnibind.JniBindEvent` (a `jdk.jfr.Event`) from its embedded
+// bytecode.  The class and methods are released in `JvmRef::~JvmRef`.
+//
+// Note: Android and Java 8 have no `jdk.jfr`, in which case `GetClass` is null.
+struct JfrEventClass {
+  static constexpr const char* kName = "com/jnibind/JniBindEvent";
+
+  static jclass GetClass() {
+    static metaprogramming::DoubleLockedValue<jclass> return_value;
+
+    return return_value.LoadAndMaybeInit([]() -> jclass {
+      // Another library in this process may have defined the class already.
+      jclass clazz = EmbeddedClass::Define(
+          kName, nullptr, kJniBindEventClassBytes,
+          static_cast<jsize>(sizeof(kJniBindEventClassBytes)));
+
+      // e.g. `NoClassDefFoundError` for `jdk.jfr.Event`, JFR is unavailable.
+      if (clazz == nullptr) {
+        JniEnv::GetEnv()->ExceptionClear();
+        return nullptr;
+      }
+
+      jclass global_clazz =
+          LifecycleHelper<jclass, LifecycleType::GLOBAL>::Promote(clazz);
+      DefaultRefs<jclass>().push_back(&return_value);
+
+      return global_clazz;
+    });
+  }
+
+  // Begins the event.
+  static jmethodID GetConstructor() {
+    static metaprogramming::EpochLockedValue<jmethodID> return_value;
+
+    return return_value.LoadAndMaybeInit(JvmEpoch::Get(), []() {
+      return JniHelper::GetMethodID(GetClass(), "<init>",
+                                    "(Ljava/lang/String;Z)V");
+    });
+  }
+
+  static jmethodID GetFinish() {
+    static metaprogramming::EpochLockedValue<jmethodID> return_value;
+
+    return return_value.LoadAndMaybeInit(JvmEpoch::Get(), []() {
+      return JniHelper::GetMethodID(GetClass(), "finish", "(J)V");
+    });
+  }
+
+  static jmethodID GetEmitPinned() {
+    static metaprogramming::EpochLockedValue<jmethodID> return_value;
+
+    return return_value.LoadAndMaybeInit(JvmEpoch::Get(), []() {
+      return JniHelper::GetStaticMethodID(GetClass(), "emitPinned",
+                                          "(Ljava/lang/String;J)V");
+    });
+  }
+};
+
+// Emits Java Flight Recorder events for sampled method invocations (named by
+// `OverloadRefUniqueId`, e.g. "com/foo/Bar#baz#(I)V") and pinned arrays
+// (`ArrayView` and `kernels::CriticalArray`), so native work shows up on the
+// same timeline as Java.  Define JNI_BIND_ENABLE_JFR_EVENTS to compile the
+// integration in (otherwise it compiles away), then call `Enable` once a
+// `JvmRef` exists.
+//
+// Each event records the JFR duration (for invocations, from just before the
+// call to just after) and the native duration.  Pinned array events are
+// emitted after the pin is released, so their JFR start time is the release.
+class JfrEvents {
+ public:
+  static constexpr bool kEnabled =
+#ifdef JNI_BIND_ENABLE_JFR_EVENTS
+      true;
+#else
+      false;
+#endif  // JNI_BIND_ENABLE_JFR_EVENTS
+
+  // Emits one event for every |sample_every| invocations or pins (counted per
+  // thread).  Returns false (and stays disabled) if JFR is unavailable.
+  static bool Enable(std::uint32_t sample_every = 1) {
+    if (!kEnabled || sample_every == 0 ||
+        JfrEventClass::GetClass() == nullptr) {
+      return false;
+    }
+
+    sample_every_.store(sample_every, std::memory_order_relaxed);
+    return true;
+  }
+
+  static void Disable() { sample_every_.store(0, std::memory_order_relaxed); }
+
+  static bool ShouldSample() {
+    std::uint32_t sample_every = sample_every_.load(std::memory_order_relaxed);
+    if (sample_every == 0) {
+      return false;
+    }
+
+    thread_local std::uint32_t count = 0;
+    if (++count < sample_every) {
+      return false;
+    }
+
+    count = 0;
+    return true;
+  }
+
+  static std::uint64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // Returns a local for a begun event, or null if one couldn't be begun.
+  static jobject BeginInvocation(const char* name) {
+    if (JniEnv::GetEnv()->ExceptionCheck()) {
+      return nullptr;
+    }
+
+    jobject event = nullptr;
+    if (jstring jname = LocalString_t::Construct(name); jname != nullptr) {
+      event = LocalObject_t::Construct(JfrEventClass::GetClass(),
+                                       JfrEventClass::GetConstructor(), jname,
+                                       JNI_FALSE);
+      LocalString_t::Delete(jname);
+    }
+
+    // Allocating or initialising the event may throw (e.g. OOM), which must
+    // not be left pending for the call being timed.
+    if (JniEnv::GetEnv()->ExceptionCheck()) {
+      JniEnv::GetEnv()->ExceptionClear();
+      if (event != nullptr) {
+        LocalObject_t::Delete(event);
+      }
+
+      return nullptr;
+    }
+
+    return event;
+  }
+
+  // Commits and releases |event|.  Events for calls which threw are dropped,
+  // as no Java may be called with an exception pending.
+  static void FinishInvocation(jobject event, std::uint64_t native_ns) {
+    if (!JniEnv::GetEnv()->ExceptionCheck()) {
+      InvokeHelper<void, 0, false>::Invoke(
+          event, JfrEventClass::GetClass(), JfrEventClass::GetFinish(),
+          static_cast<jlong>(native_ns));
+      ClearOwnException();
+    }
+
+    LocalObject_t::Delete(event);
+  }
+
+  // Must be called after the pin is released.  No JNI calls may be made until
+  // every critical pin on the thread is released, so until then events are
+  // deferred.
+  static void EmitPinned(const char* name, std::uint64_t native_ns) {
+    std::vector<std::pair<const char*, std::uint64_t>>& pending = PendingPins();
+    pending.emplace_back(name, native_ns);
+
+    if (CriticalDepth() != 0 || JniEnv::GetEnv()->ExceptionCheck()) {
+      return;
+    }
+
+    for (const auto& [pending_name, pending_ns] : pending) {
+      jstring jname = LocalString_t::Construct(pending_name);
+      InvokeHelper<void, 0, true>::Invoke(
+          nullptr, JfrEventClass::GetClass(), JfrEventClass::GetEmitPinned(),
+          jname, static_cast<jlong>(pending_ns));
+      ClearOwnException();
+      LocalString_t::Delete(jname);
+    }
+    pending.clear();
+  }
+
+  // Critical pins held by this thread (see `JfrPinTimer`).
+  static std::size_t& CriticalDepth() {
+    thread_local std::size_t depth = 0;
+
+    return depth;
+  }
+
+ private:
+  using LocalObject_t = LifecycleHelper<jobject, LifecycleType::LOCAL>;
+  using LocalString_t = LifecycleHelper<jstring, LifecycleType::LOCAL>;
+
+  static std::vector<std::pair<const char*, std::uint64_t>>& PendingPins() {
+    thread_local std::vector<std::pair<const char*, std::uint64_t>> pending;
+
+    return pending;
+  }
+
+  // Events are best effort and must never surface to the caller.
+  static void ClearOwnException() {
+    if (JniEnv::GetEnv()->ExceptionCheck()) {
+      JniEnv::GetEnv()->ExceptionClear();
+    }
+  }
+
+  static inline std::atomic<std::uint32_t> sample_every_{0};
+};
+
+// Emits an invocation event for the lifetime of the scope (if sampled).  Empty
+// unless JFR events are enabled.
+template <bool kEnabled = JfrEvents::kEnabled>
+class JfrInvocationScope {
+ public:
+  explicit JfrInvocationScope(std::string_view) {}
+};
+
+template <>
+class JfrInvocationScope<true> {
+ public:
+  // |name| must be null terminated.
+  explicit JfrInvocationScope(std::string_view name) {
+    if (JfrEvents::ShouldSample()) {
+      event_ = JfrEvents::BeginInvocation(name.data());
+      start_ns_ = JfrEvents::NowNs();
+    }
+  }
+
+  JfrInvocationScope(const JfrInvocationScope&) = delete;
+  JfrInvocationScope& operator=(const JfrInvocationScope&) = delete;
+
+  ~JfrInvocationScope() {
+    if (event_ != nullptr) {
+      JfrEvents::FinishInvocation(event_, JfrEvents::NowNs() - start_ns_);
+    }
+  }
+
+ private:
+  jobject event_ = nullptr;
+  std::uint64_t start_ns_ = 0;
+};
+
+// Times a pin (if sampled).  Empty unless JFR events are enabled.
+template <bool kEnabled = JfrEvents::kEnabled>
+class JfrPinTimer {
+ protected:
+  void StartPin(bool /*critical*/ = false) {}
+  void EndPin(const char*) {}
+};
+
+template <>
+class JfrPinTimer<true> {
+ protected:
+  // Must be called after the pin is made.
+  void StartPin(bool critical = false) {
+    critical_ = critical;
+    if (critical_) {
+      ++JfrEvents::CriticalDepth();
+    }
+
+    sampled_ = JfrEvents::ShouldSample();
+    if (sampled_) {
+      start_ns_ = JfrEvents::NowNs();
+    }
+  }
+
+  // Must be called after the pin is released.
+  void EndPin(const char* name) {
+    if (critical_) {
+      --JfrEvents::CriticalDepth();
+    }
+
+    if (sampled_) {
+      JfrEvents::EmitPinned(name, JfrEvents::NowNs() - start_ns_);
+    }
+  }
+
+ private:
+  bool critical_ = false;
+  bool sampled_ = false;
+  std::uint64_t start_ns_ = 0;
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_JFR_EVENTS_H_
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "implementation/jfr_events.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::AdoptLocal;
+using ::jni::Class;
+using ::jni::Fake;
+using ::jni::JfrEvents;
+using ::jni::LocalArray;
+using ::jni::LocalObject;
+using ::jni::Method;
+using ::jni::Params;
+using ::jni::kernels::CriticalArray;
+using ::jni::test::AsGlobal;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+using ::testing::Return;
+using ::testing::StrEq;
+
+static_assert(JfrEvents::kEnabled);
+
+static constexpr Class kClass{"kClass",
+                              Method{"Foo", jni::Return<void>{}, Params{}}};
+
+class JfrEventsTest : public JniTest {
+ public:
+  void SetUp() override {
+    JniTest::SetUp();
+    ON_CALL(*env_, DefineClass(StrEq("com/jnibind/JniBindEvent"), _, _, _))
+        .WillByDefault(Return(Fake<jclass>(3)));
+    ON_CALL(*env_, GetMethodID(_, StrEq("<init>"),
+                               StrEq("(Ljava/lang/String;Z)V")))
+        .WillByDefault(Return(Fake<jmethodID>(3)));
+    ON_CALL(*env_, GetMethodID(_, StrEq("finish"), StrEq("(J)V")))
+        .WillByDefault(Return(Fake<jmethodID>(4)));
+    ON_CALL(*env_, GetStaticMethodID(_, StrEq("emitPinned"),
+                                     StrEq("(Ljava/lang/String;J)V")))
+        .WillByDefault(Return(Fake<jmethodID>(5)));
+    ON_CALL(*env_, NewStringUTF).WillByDefault(Return(Fake<jstring>()));
+    ON_CALL(*env_, NewObjectV(_, Fake<jmethodID>(3), _))
+        .WillByDefault(Return(Fake<jobject>(3)));
+    EXPECT_CALL(*env_, DeleteGlobalRef).Times(AnyNumber());
+    EXPECT_CALL(*env_, DeleteLocalRef).Times(AnyNumber());
+
+    ASSERT_TRUE(JfrEvents::Enable());
+  }
+
+  void TearDown() override {
+    JfrEvents::Disable();
+    JniTest::TearDown();
+  }
+};
+
+TEST_F(JfrEventsTest, EmitsEventAroundInvocation) {
+  InSequence seq;
+  EXPECT_CALL(*env_, NewObjectV(AsGlobal(Fake<jclass>(3)), Fake<jmethodID>(3),
+                                _));
+  EXPECT_CALL(*env_, CallVoidMethodV(Fake<jobject>(), Fake<jmethodID>(), _));
+  EXPECT_CALL(*env_,
+              CallVoidMethodV(Fake<jobject>(3), Fake<jmethodID>(4), _));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jobject>(3)));
+
+  LocalObject<kClass> obj{AdoptLocal{}, Fake<jobject>()};
+  obj("Foo");
+}
+
+TEST_F(JfrEventsTest, SamplesEveryNthInvocation) {
+  ASSERT_TRUE(JfrEvents::Enable(2));
+  EXPECT_CALL(*env_, NewObjectV(_, Fake<jmethodID>(3), _)).Times(2);
+
+  LocalObject<kClass> obj{AdoptLocal{}, Fake<jobject>()};
+  for (int i = 0; i < 4; ++i) {
+    obj("Foo");
+  }
+}
+
+TEST_F(JfrEventsTest, DropsEventWhenInvocationThrows) {
+  // Checked before and after beginning the event, then after the call.
+  EXPECT_CALL(*env_, ExceptionCheck)
+      .WillOnce(Return(JNI_FALSE))
+      .WillOnce(Return(JNI_FALSE))
+      .WillRepeatedly(Return(JNI_TRUE));
+  EXPECT_CALL(*env_, CallVoidMethodV(_, Fake<jmethodID>(4), _)).Times(0);
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jobject>(3)));
+
+  LocalObject<kClass> obj{AdoptLocal{}, Fake<jobject>()};
+  obj("Foo");
+}
+
+TEST_F(JfrEventsTest, ClearsExceptionFromBeginningEventBeforeCall) {
+  EXPECT_CALL(*env_, ExceptionCheck)
+      .WillOnce(Return(JNI_FALSE))
+      .WillOnce(Return(JNI_TRUE))
+      .WillRepeatedly(Return(JNI_FALSE));
+
+  InSequence seq;
+  EXPECT_CALL(*env_, ExceptionClear);
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jobject>(3)));
+  EXPECT_CALL(*env_, CallVoidMethodV(Fake<jobject>(), Fake<jmethodID>(), _));
+  EXPECT_CALL(*env_, CallVoidMethodV(_, Fake<jmethodID>(4), _)).Times(0);
+
+  LocalObject<kClass> obj{AdoptLocal{}, Fake<jobject>()};
+  obj("Foo");
+}
+
+TEST_F(JfrEventsTest, NoEventsWhenDisabled) {
+  JfrEvents::Disable();
+  EXPECT_CALL(*env_, NewObjectV).Times(0);
+
+  LocalObject<kClass> obj{AdoptLocal{}, Fake<jobject>()};
+  obj("Foo");
+}
+
+TEST_F(JfrEventsTest, EmitsPinnedArrayAfterRelease) {
+  LocalArray<jint> array{AdoptLocal{}, Fake<jintArray>()};
+
+  InSequence seq;
+  EXPECT_CALL(*env_, ReleaseIntArrayElements);
+  EXPECT_CALL(*env_, CallStaticVoidMethodV(AsGlobal(Fake<jclass>(3)),
+                                           Fake<jmethodID>(5), _));
+
+  { auto view = array.Pin(); }
+}
+
+TEST_F(JfrEventsTest, DefersPinnedEventsUntilLastCriticalPinReleased) {
+  LocalArray<jint> array{AdoptLocal{}, Fake<jintArray>()};
+
+  InSequence seq;
+  EXPECT_CALL(*env_, ReleasePrimitiveArrayCritical).Times(2);
+  EXPECT_CALL(*env_, CallStaticVoidMethodV(_, Fake<jmethodID>(5), _)).Times(2);
+
+  CriticalArray<jint> outer{static_cast<jintArray>(array)};
+  { CriticalArray<jint> inner{static_cast<jintArray>(array)}; }
+}
+
+}  // namespace
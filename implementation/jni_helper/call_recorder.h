@@ -0,0 +1,288 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef JNI_BIND_IMPLEMENTATION_JNI_HELPER_CALL_RECORDER_H_
+#define JNI_BIND_IMPLEMENTATION_JNI_HELPER_CALL_RECORDER_H_
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>  // NOLINT
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include "jni_dep.h"
+#include "metaprogramming/lambda_string.h"
+
+namespace jni {
+
+// A recording starts with `kCallRecordingMagic` and is followed by entries,
+// each beginning with a `RecordTag`.  All integers are LEB128 varints.
+//
+//   kName:   id, length, bytes.  Precedes the first call using the name.
+//   kCall:   name id, thread index, ns since the previous entry, arg count,
+//            args.
+//   kResult: thread index, arg.  The result of the thread's previous call.
+//
+// Each arg is a `RecordedArgKind` followed by its payload:
+//
+//   kHandle: the handle's value (jobject, jclass, jmethodID, jfieldID, ...).
+//   kInt:    zigzag encoded value.
+//   kFloat:  8 byte little endian double.
+//   kString: length, bytes.
+//   kNull and kOpaque (buffers, va_lists, ...) have no payload.
+inline constexpr std::string_view kCallRecordingMagic{"JNIBREC1"};
+
+enum class RecordTag : std::uint8_t {
+  kName = 1,
+  kCall = 2,
+  kResult = 3,
+};
+
+enum class RecordedArgKind : std::uint8_t {
+  kNull = 0,
+  kHandle = 1,
+  kInt = 2,
+  kFloat = 3,
+  kString = 4,
+  kOpaque = 5,
+};
+
+// Writes a compact binary log of every JNI call JNI Bind makes (see `Trace`),
+// which can be re-issued later by `CallReplayer`.  Define
+// JNI_BIND_ENABLE_RECORDING to compile recording in (otherwise it compiles
+// away) and then bracket the calls of interest with `Start` and `Stop`.
+//
+// Only the results needed to re-resolve handles on replay are recorded (see
+// `TraceResult`).  Timing is the interval between the issue of each call.
+class CallRecorder {
+ public:
+  static constexpr bool kEnabled =
+#ifdef JNI_BIND_ENABLE_RECORDING
+      true;
+#else
+      false;
+#endif  // JNI_BIND_ENABLE_RECORDING
+
+  // Begins recording to |out|, which must remain open until `Stop`.  Returns
+  // false if already recording (or recording is compiled out).
+  static bool Start(std::FILE* out) {
+    if constexpr (!kEnabled) {
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (out_ != nullptr) {
+      return false;
+    }
+
+    out_ = out;
+    names_.clear();
+    last_ns_ = NowNs();
+    std::fwrite(kCallRecordingMagic.data(), 1, kCallRecordingMagic.size(),
+                out_);
+    recording_.store(true, std::memory_order_release);
+
+    return true;
+  }
+
+  // Stops recording and flushes (but does not close) the output.
+  static void Stop() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (out_ == nullptr) {
+      return;
+    }
+
+    recording_.store(false, std::memory_order_release);
+    std::fflush(out_);
+    out_ = nullptr;
+  }
+
+  static bool IsRecording() {
+    return kEnabled && recording_.load(std::memory_order_relaxed);
+  }
+
+  template <char... chars, typename... Args>
+  static void RecordCall(metaprogramming::StringAsType<chars...>,
+                         const Args&... args) {
+    if constexpr (kEnabled) {
+      if (!IsRecording()) {
+        return;
+      }
+
+      static constexpr std::string_view kName =
+          metaprogramming::StringAsType<chars...>::chars_as_sv;
+
+      std::string& encoded_args = ScratchBuffer();
+      encoded_args.clear();
+      (EncodeArg(encoded_args, args), ...);
+
+      std::lock_guard<std::mutex> lock{mutex_};
+      if (out_ == nullptr) {
+        return;
+      }
+
+      std::size_t name_id = InternName(kName);
+      std::uint64_t now_ns = NowNs();
+
+      std::string entry;
+      entry.push_back(static_cast<char>(RecordTag::kCall));
+      EncodeVarint(entry, name_id);
+      EncodeVarint(entry, ThreadIndex());
+      EncodeVarint(entry, now_ns - last_ns_);
+      EncodeVarint(entry, sizeof...(Args));
+      entry.append(encoded_args);
+      last_ns_ = now_ns;
+
+      std::fwrite(entry.data(), 1, entry.size(), out_);
+    }
+  }
+
+  template <typename T>
+  static void RecordResult(const T& result) {
+    if constexpr (kEnabled) {
+      if (!IsRecording()) {
+        return;
+      }
+
+      std::string entry;
+      entry.push_back(static_cast<char>(RecordTag::kResult));
+      EncodeVarint(entry, ThreadIndex());
+      EncodeArg(entry, result);
+
+      std::lock_guard<std::mutex> lock{mutex_};
+      if (out_ != nullptr) {
+        std::fwrite(entry.data(), 1, entry.size(), out_);
+      }
+    }
+  }
+
+  static void EncodeVarint(std::string& out, std::uint64_t val) {
+    while (val >= 0x80) {
+      out.push_back(static_cast<char>((val & 0x7F) | 0x80));
+      val >>= 7;
+    }
+    out.push_back(static_cast<char>(val));
+  }
+
+ private:
+  template <typename T>
+  static constexpr bool IsHandle() {
+    if constexpr (std::is_pointer_v<T>) {
+      using Pointee = std::remove_cv_t<std::remove_pointer_t<T>>;
+
+      // IDs are incomplete types, so are excluded before `is_base_of`.
+      if constexpr (std::is_same_v<Pointee, _jmethodID> ||
+                    std::is_same_v<Pointee, _jfieldID>) {
+        return true;
+      } else if constexpr (std::is_class_v<Pointee>) {
+        return std::is_base_of_v<_jobject, Pointee>;
+      } else {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+
+  static void EncodeString(std::string& out, std::string_view str) {
+    out.push_back(static_cast<char>(RecordedArgKind::kString));
+    EncodeVarint(out, str.size());
+    out.append(str);
+  }
+
+  template <typename T>
+  static void EncodeArg(std::string& out, const T& arg) {
+    if constexpr (std::is_same_v<T, const char*>) {
+      if (arg == nullptr) {
+        out.push_back(static_cast<char>(RecordedArgKind::kNull));
+      } else {
+        EncodeString(out, arg);
+      }
+    } else if constexpr (IsHandle<T>()) {
+      if (arg == nullptr) {
+        out.push_back(static_cast<char>(RecordedArgKind::kNull));
+      } else {
+        out.push_back(static_cast<char>(RecordedArgKind::kHandle));
+        EncodeVarint(out, reinterpret_cast<std::uintptr_t>(arg));
+      }
+    } else if constexpr (std::is_integral_v<T>) {
+      auto val = static_cast<std::int64_t>(arg);
+      out.push_back(static_cast<char>(RecordedArgKind::kInt));
+      EncodeVarint(out, (static_cast<std::uint64_t>(val) << 1) ^
+                            static_cast<std::uint64_t>(val >> 63));
+    } else if constexpr (std::is_floating_point_v<T>) {
+      auto val = static_cast<double>(arg);
+      std::uint64_t bits;
+      std::memcpy(&bits, &val, sizeof(bits));
+
+      out.push_back(static_cast<char>(RecordedArgKind::kFloat));
+      for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+      }
+    } else {
+      out.push_back(static_cast<char>(RecordedArgKind::kOpaque));
+    }
+  }
+
+  // Must be called under |mutex_|.  Names are emitted once per recording.
+  static std::size_t InternName(std::string_view name) {
+    auto [it, inserted] = names_.emplace(name, names_.size());
+    if (inserted) {
+      std::string entry;
+      entry.push_back(static_cast<char>(RecordTag::kName));
+      EncodeVarint(entry, it->second);
+      EncodeVarint(entry, name.size());
+      entry.append(name);
+      std::fwrite(entry.data(), 1, entry.size(), out_);
+    }
+
+    return it->second;
+  }
+
+  static std::uint64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  static std::uint32_t ThreadIndex() {
+    static std::atomic<std::uint32_t> next_index{0};
+    thread_local std::uint32_t index = next_index++;
+
+    return index;
+  }
+
+  static std::string& ScratchBuffer() {
+    thread_local std::string buffer;
+
+    return buffer;
+  }
+
+  static inline std::atomic<bool> recording_{false};
+  static inline std::mutex mutex_;
+  static inline std::FILE* out_ = nullptr;
+  static inline std::uint64_t last_ns_ = 0;
+  static inline std::unordered_map<std::string_view, std::size_t> names_;
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_JNI_HELPER_CALL_RECORDER_H_
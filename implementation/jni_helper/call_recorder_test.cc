@@ -0,0 +1,176 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "implementation/jni_helper/call_recorder.h"
+
+#include <cstdint>
+#include <cstdio>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/call_replay.h"
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::CallLogReader;
+using ::jni::CallRecorder;
+using ::jni::CallReplayer;
+using ::jni::Class;
+using ::jni::Fake;
+using ::jni::Method;
+using ::jni::Params;
+using ::jni::RecordedArgKind;
+using ::jni::RecordedCall;
+using ::jni::ReplayStats;
+using ::jni::Static;
+using ::jni::StaticRef;
+using ::jni::test::AsGlobal;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::StrEq;
+
+static_assert(CallRecorder::kEnabled);
+
+// clang-format off
+static constexpr Class kClass{
+  "kClass",
+  Static {
+    Method{"Foo", jni::Return<jint>{}, Params<jint, jfloat>{}},
+  },
+};
+// clang-format on
+
+class CallRecorderTest : public JniTest {
+ public:
+  void SetUp() override {
+    JniTest::SetUp();
+    ON_CALL(*env_, GetStaticMethodID).WillByDefault(Return(Fake<jmethodID>()));
+    EXPECT_CALL(*env_, DeleteGlobalRef).Times(AnyNumber());
+  }
+
+  // Records a single static call to `Foo`.
+  std::FILE* Record() {
+    std::FILE* file = std::tmpfile();
+    EXPECT_TRUE(CallRecorder::Start(file));
+    EXPECT_FALSE(CallRecorder::Start(file));
+
+    StaticRef<kClass>{}("Foo", 5, 2.5f);
+
+    CallRecorder::Stop();
+    std::rewind(file);
+
+    return file;
+  }
+};
+
+TEST_F(CallRecorderTest, RecordsNamesArgsAndResults) {
+  std::FILE* file = Record();
+  CallLogReader reader{file};
+  ASSERT_TRUE(reader.Valid());
+
+  bool saw_method_lookup = false;
+  bool saw_method_id = false;
+  bool saw_call = false;
+  RecordedCall call;
+  while (reader.Next(&call)) {
+    if (call.name == "GetStaticMethodID") {
+      ASSERT_EQ(call.args.size(), 3);
+      EXPECT_EQ(call.args[1].str, "Foo");
+      EXPECT_EQ(call.args[2].str, "(IF)I");
+      saw_method_lookup = true;
+
+      ASSERT_TRUE(reader.Next(&call));
+      EXPECT_TRUE(call.is_result);
+      EXPECT_EQ(call.args[0].kind, RecordedArgKind::kHandle);
+      EXPECT_EQ(call.args[0].handle,
+                reinterpret_cast<std::uintptr_t>(Fake<jmethodID>()));
+      saw_method_id = true;
+    } else if (call.name == "CallStaticIntMethod") {
+      ASSERT_EQ(call.args.size(), 4);
+      EXPECT_EQ(call.args[2].kind, RecordedArgKind::kInt);
+      EXPECT_EQ(call.args[2].i, 5);
+      EXPECT_EQ(call.args[3].kind, RecordedArgKind::kFloat);
+      EXPECT_EQ(call.args[3].f, 2.5);
+      saw_call = true;
+    }
+  }
+
+  EXPECT_TRUE(saw_method_lookup);
+  EXPECT_TRUE(saw_method_id);
+  EXPECT_TRUE(saw_call);
+  std::fclose(file);
+}
+
+TEST_F(CallRecorderTest, RejectsInputThatIsNotARecording) {
+  std::FILE* file = std::tmpfile();
+  std::fputs("not a recording", file);
+  std::rewind(file);
+
+  CallLogReader reader{file};
+  RecordedCall call;
+  EXPECT_FALSE(reader.Valid());
+  EXPECT_FALSE(reader.Next(&call));
+  std::fclose(file);
+}
+
+TEST_F(CallRecorderTest, ReplayTranslatesHandlesAndTypesArgs) {
+  std::FILE* file = Record();
+
+  // The replayed env hands out different handles than the recorded one.
+  EXPECT_CALL(*env_, FindClass(StrEq("kClass")))
+      .WillOnce(Return(Fake<jclass>(2)));
+  EXPECT_CALL(*env_, GetStaticMethodID(AsGlobal(Fake<jclass>(2)), StrEq("Foo"),
+                                       StrEq("(IF)I")))
+      .WillOnce(Return(Fake<jmethodID>(2)));
+  EXPECT_CALL(*env_, CallStaticIntMethodA(AsGlobal(Fake<jclass>(2)),
+                                          Fake<jmethodID>(2), _))
+      .WillOnce(Invoke([](jclass, jmethodID, const jvalue* args) {
+        EXPECT_EQ(args[0].i, 5);
+        EXPECT_EQ(args[1].f, 2.5f);
+        return 7;
+      }));
+
+  CallLogReader reader{file};
+  ReplayStats stats = CallReplayer{}.Replay(reader);
+
+  EXPECT_GT(stats.reissued, 0);
+  EXPECT_EQ(stats.unresolved, 0);
+  std::fclose(file);
+}
+
+TEST_F(CallRecorderTest, ReplaySkipsCallsOnHandlesItNeverProduced) {
+  std::FILE* file = std::tmpfile();
+  CallRecorder::Start(file);
+  jni::JniHelper::GetObjectClass(Fake<jobject>());
+  CallRecorder::Stop();
+  std::rewind(file);
+
+  EXPECT_CALL(*env_, GetObjectClass).Times(0);
+
+  CallLogReader reader{file};
+  ReplayStats stats = CallReplayer{}.Replay(reader);
+
+  EXPECT_EQ(stats.reissued, 0);
+  EXPECT_EQ(stats.unresolved, 1);
+  std::fclose(file);
+}
+
+}  // namespace
@@ -0,0 +1,557 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef JNI_BIND_IMPLEMENTATION_JNI_HELPER_CALL_REPLAY_H_
+#define JNI_BIND_IMPLEMENTATION_JNI_HELPER_CALL_REPLAY_H_
+
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "implementation/jni_helper/call_recorder.h"
+#include "implementation/jni_helper/jni_env.h"
+#include "jni_dep.h"
+
+namespace jni {
+
+struct RecordedArg {
+  RecordedArgKind kind = RecordedArgKind::kNull;
+  std::uint64_t handle = 0;
+  std::int64_t i = 0;
+  double f = 0;
+  std::string str;
+};
+
+// A call (or the result of the thread's previous call) from a recording.
+struct RecordedCall {
+  bool is_result = false;
+  std::string_view name;
+  std::uint32_t thread = 0;
+  std::uint64_t timestamp_ns = 0;
+  std::vector<RecordedArg> args;
+};
+
+// Reads a recording written by `CallRecorder`.
+class CallLogReader {
+ public:
+  explicit CallLogReader(std::FILE* in) : in_(in) {
+    char magic[kCallRecordingMagic.size()];
+    valid_ = std::fread(magic, 1, sizeof(magic), in_) == sizeof(magic) &&
+             std::string_view{magic, sizeof(magic)} == kCallRecordingMagic;
+  }
+
+  // False if the input is not a recording.
+  bool Valid() const { return valid_; }
+
+  // Reads the next call or result into |out|.  Returns false at the end of the
+  // recording (or if it is truncated).
+  bool Next(RecordedCall* out) {
+    while (valid_) {
+      int tag = std::fgetc(in_);
+      if (tag == EOF) {
+        return false;
+      }
+
+      switch (static_cast<RecordTag>(tag)) {
+        case RecordTag::kName: {
+          std::uint64_t id;
+          std::string name;
+          if (!ReadVarint(&id) || !ReadString(&name)) {
+            return valid_ = false;
+          }
+          if (names_.size() <= id) {
+            names_.resize(id + 1);
+          }
+          names_[id] = std::move(name);
+          break;
+        }
+        case RecordTag::kCall: {
+          std::uint64_t id, thread, delta_ns, argc;
+          if (!ReadVarint(&id) || id >= names_.size() ||
+              !ReadVarint(&thread) || !ReadVarint(&delta_ns) ||
+              !ReadVarint(&argc)) {
+            return valid_ = false;
+          }
+
+          timestamp_ns_ += delta_ns;
+          out->is_result = false;
+          out->name = names_[id];
+          out->thread = static_cast<std::uint32_t>(thread);
+          out->timestamp_ns = timestamp_ns_;
+          out->args.resize(argc);
+          for (RecordedArg& arg : out->args) {
+            if (!ReadArg(&arg)) {
+              return valid_ = false;
+            }
+          }
+          return true;
+        }
+        case RecordTag::kResult: {
+          std::uint64_t thread;
+          out->args.resize(1);
+          if (!ReadVarint(&thread) || !ReadArg(&out->args[0])) {
+            return valid_ = false;
+          }
+
+          out->is_result = true;
+          out->name = {};
+          out->thread = static_cast<std::uint32_t>(thread);
+          out->timestamp_ns = timestamp_ns_;
+          return true;
+        }
+        default:
+          return valid_ = false;
+      }
+    }
+
+    return false;
+  }
+
+ private:
+  bool ReadVarint(std::uint64_t* out) {
+    *out = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      int byte = std::fgetc(in_);
+      if (byte == EOF) {
+        return false;
+      }
+
+      *out |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool ReadString(std::string* out) {
+    std::uint64_t size;
+    if (!ReadVarint(&size)) {
+      return false;
+    }
+
+    out->resize(size);
+    return std::fread(out->data(), 1, size, in_) == size;
+  }
+
+  bool ReadArg(RecordedArg* out) {
+    int kind = std::fgetc(in_);
+    if (kind == EOF) {
+      return false;
+    }
+
+    *out = RecordedArg{};
+    out->kind = static_cast<RecordedArgKind>(kind);
+    switch (out->kind) {
+      case RecordedArgKind::kNull:
+      case RecordedArgKind::kOpaque:
+        return true;
+      case RecordedArgKind::kHandle:
+        return ReadVarint(&out->handle);
+      case RecordedArgKind::kInt: {
+        std::uint64_t zigzag;
+        if (!ReadVarint(&zigzag)) {
+          return false;
+        }
+        out->i = static_cast<std::int64_t>(zigzag >> 1) ^
+                 -static_cast<std::int64_t>(zigzag & 1);
+        return true;
+      }
+      case RecordedArgKind::kFloat: {
+        unsigned char bytes[8];
+        if (std::fread(bytes, 1, sizeof(bytes), in_) != sizeof(bytes)) {
+          return false;
+        }
+
+        std::uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) {
+          bits |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+        }
+        std::memcpy(&out->f, &bits, sizeof(bits));
+        return true;
+      }
+      case RecordedArgKind::kString:
+        return ReadString(&out->str);
+    }
+
+    return false;
+  }
+
+  std::FILE* in_;
+  bool valid_;
+  std::uint64_t timestamp_ns_ = 0;
+  std::vector<std::string> names_;
+};
+
+enum class ReplayPacing {
+  // Calls are issued back to back.
+  kAsFastAsPossible,
+  // Calls are issued with the intervals they were recorded with.
+  kRecorded,
+};
+
+struct ReplayStats {
+  // Calls issued against the current `JNIEnv`.
+  std::size_t reissued = 0;
+  // Calls with no replay equivalent (e.g. field accesses, array regions).
+  std::size_t unsupported = 0;
+  // Calls referring to a handle the replay never produced.
+  std::size_t unresolved = 0;
+};
+
+// Re-issues a recording against the current thread's `JNIEnv` (see `JniEnv`),
+// which may be an embedded JVM or a fake.  Calls from every recorded thread
+// are issued serially on the calling thread in the order they were recorded.
+//
+// Handles in the recording are translated to those produced by the replay
+// (e.g. a recorded `FindClass` result maps to the replayed `FindClass`
+// result).  Calls re-issued are class, method and field lookups, reference
+// management, constructors and method calls (with arguments typed from the
+// method's signature).  Anything else is counted as unsupported.
+class CallReplayer {
+ public:
+  ReplayStats Replay(CallLogReader& reader,
+                     ReplayPacing pacing = ReplayPacing::kAsFastAsPossible) {
+    ReplayStats stats;
+    RecordedCall call;
+    bool started = false;
+    std::uint64_t first_ns = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    while (reader.Next(&call)) {
+      if (call.is_result) {
+        MapResult(call);
+        continue;
+      }
+
+      if (pacing == ReplayPacing::kRecorded) {
+        if (!started) {
+          first_ns = call.timestamp_ns;
+          started = true;
+        }
+        std::this_thread::sleep_until(
+            start + std::chrono::nanoseconds(call.timestamp_ns - first_ns));
+      }
+
+      last_results_.erase(call.thread);
+      switch (Reissue(call)) {
+        case Outcome::kReissued:
+          ++stats.reissued;
+          break;
+        case Outcome::kUnsupported:
+          ++stats.unsupported;
+          break;
+        case Outcome::kUnresolved:
+          ++stats.unresolved;
+          break;
+      }
+    }
+
+    return stats;
+  }
+
+ private:
+  enum class Outcome { kReissued, kUnsupported, kUnresolved };
+
+  static constexpr std::string_view kCallPrefix = "Call";
+  static constexpr std::string_view kStaticPrefix = "CallStatic";
+  static constexpr std::string_view kMethod = "Method";
+
+  // Maps a recorded result to the result of the replayed call.
+  void MapResult(const RecordedCall& result) {
+    auto it = last_results_.find(result.thread);
+    if (it != last_results_.end() &&
+        result.args[0].kind == RecordedArgKind::kHandle) {
+      handles_[result.args[0].handle] = it->second;
+    }
+    last_results_.erase(result.thread);
+  }
+
+  bool Resolve(const RecordedArg& arg, void** out) const {
+    if (arg.kind == RecordedArgKind::kNull) {
+      *out = nullptr;
+      return true;
+    }
+    if (arg.kind != RecordedArgKind::kHandle) {
+      return false;
+    }
+
+    auto it = handles_.find(arg.handle);
+    if (it == handles_.end()) {
+      return false;
+    }
+
+    *out = it->second;
+    return true;
+  }
+
+  template <typename T>
+  bool Resolve(const RecordedArg& arg, T* out) const {
+    void* live;
+    if (!Resolve(arg, &live)) {
+      return false;
+    }
+
+    *out = reinterpret_cast<T>(live);
+    return true;
+  }
+
+  template <typename T>
+  Outcome Produced(const RecordedCall& call, T live) {
+    if (live != nullptr) {
+      last_results_[call.thread] = reinterpret_cast<void*>(live);
+    }
+
+    return Outcome::kReissued;
+  }
+
+  // Types |args| (from |first_arg| on) against |signature|'s params.
+  bool ToJvalues(std::string_view signature,
+                 const std::vector<RecordedArg>& args, std::size_t first_arg,
+                 std::vector<jvalue>* out) const {
+    out->clear();
+    std::size_t pos = signature.find('(') + 1;
+    std::size_t arg_idx = first_arg;
+
+    while (pos < signature.size() && signature[pos] != ')') {
+      if (arg_idx >= args.size()) {
+        return false;
+      }
+
+      const RecordedArg& arg = args[arg_idx++];
+      const char type = signature[pos];
+      jvalue val;
+      std::memset(&val, 0, sizeof(val));
+
+      // Arrays and objects are both references.
+      if (type == '[' || type == 'L') {
+        while (signature[pos] == '[') {
+          ++pos;
+        }
+        if (signature[pos] == 'L') {
+          pos = signature.find(';', pos);
+        }
+        if (!Resolve(arg, &val.l)) {
+          return false;
+        }
+      } else {
+        const bool is_float = arg.kind == RecordedArgKind::kFloat;
+        switch (type) {
+          case 'Z': val.z = static_cast<jboolean>(arg.i); break;
+          case 'B': val.b = static_cast<jbyte>(arg.i); break;
+          case 'C': val.c = static_cast<jchar>(arg.i); break;
+          case 'S': val.s = static_cast<jshort>(arg.i); break;
+          case 'I': val.i = static_cast<jint>(arg.i); break;
+          case 'J': val.j = static_cast<jlong>(arg.i); break;
+          case 'F':
+            val.f = static_cast<jfloat>(is_float ? arg.f : arg.i);
+            break;
+          case 'D':
+            val.d = static_cast<jdouble>(is_float ? arg.f : arg.i);
+            break;
+          default:
+            return false;
+        }
+      }
+
+      ++pos;
+      out->push_back(val);
+    }
+
+    return true;
+  }
+
+  // Issues |method| with the return type from its signature.  Returns the
+  // result if it is a reference.
+  jobject CallMethod(bool is_static, jobject object, jclass clazz,
+                     jmethodID method, std::string_view signature,
+                     const jvalue* args) {
+    JNIEnv* env = JniEnv::GetEnv();
+    const char return_type = signature[signature.find(')') + 1];
+
+    if (is_static) {
+      switch (return_type) {
+        case 'V': env->CallStaticVoidMethodA(clazz, method, args); break;
+        case 'Z': env->CallStaticBooleanMethodA(clazz, method, args); break;
+        case 'B': env->CallStaticByteMethodA(clazz, method, args); break;
+        case 'C': env->CallStaticCharMethodA(clazz, method, args); break;
+        case 'S': env->CallStaticShortMethodA(clazz, method, args); break;
+        case 'I': env->CallStaticIntMethodA(clazz, method, args); break;
+        case 'J': env->CallStaticLongMethodA(clazz, method, args); break;
+        case 'F': env->CallStaticFloatMethodA(clazz, method, args); break;
+        case 'D': env->CallStaticDoubleMethodA(clazz, method, args); break;
+        default: return env->CallStaticObjectMethodA(clazz, method, args);
+      }
+    } else {
+      switch (return_type) {
+        case 'V': env->CallVoidMethodA(object, method, args); break;
+        case 'Z': env->CallBooleanMethodA(object, method, args); break;
+        case 'B': env->CallByteMethodA(object, method, args); break;
+        case 'C': env->CallCharMethodA(object, method, args); break;
+        case 'S': env->CallShortMethodA(object, method, args); break;
+        case 'I': env->CallIntMethodA(object, method, args); break;
+        case 'J': env->CallLongMethodA(object, method, args); break;
+        case 'F': env->CallFloatMethodA(object, method, args); break;
+        case 'D': env->CallDoubleMethodA(object, method, args); break;
+        default: return env->CallObjectMethodA(object, method, args);
+      }
+    }
+
+    return nullptr;
+  }
+
+  Outcome ReissueLookup(const RecordedCall& call, bool is_method,
+                        bool is_static) {
+    jclass clazz;
+    if (call.args.size() != 3 || !Resolve(call.args[0], &clazz)) {
+      return Outcome::kUnresolved;
+    }
+
+    JNIEnv* env = JniEnv::GetEnv();
+    const char* name = call.args[1].str.c_str();
+    const std::string& signature = call.args[2].str;
+
+    if (!is_method) {
+      return Produced(call, is_static ? env->GetStaticFieldID(
+                                            clazz, name, signature.c_str())
+                                      : env->GetFieldID(clazz, name,
+                                                        signature.c_str()));
+    }
+
+    jmethodID method =
+        is_static ? env->GetStaticMethodID(clazz, name, signature.c_str())
+                  : env->GetMethodID(clazz, name, signature.c_str());
+    if (method != nullptr) {
+      signatures_[method] = signature;
+    }
+
+    return Produced(call, method);
+  }
+
+  // Recorded as (object, clazz, method, args...) or, if static, (clazz,
+  // method, args...).  Constructors are recorded as (clazz, method, args...).
+  Outcome ReissueCall(const RecordedCall& call, bool is_static,
+                      bool is_constructor) {
+    const std::size_t method_idx = (is_static || is_constructor) ? 1 : 2;
+    jobject object = nullptr;
+    jclass clazz = nullptr;
+    jmethodID method;
+
+    if (call.args.size() <= method_idx ||
+        (method_idx == 2 && !Resolve(call.args[0], &object)) ||
+        !Resolve(call.args[method_idx - 1], &clazz) ||
+        !Resolve(call.args[method_idx], &method)) {
+      return Outcome::kUnresolved;
+    }
+
+    auto signature = signatures_.find(method);
+    if (signature == signatures_.end() ||
+        !ToJvalues(signature->second, call.args, method_idx + 1, &jvalues_)) {
+      return Outcome::kUnresolved;
+    }
+
+    if (is_constructor) {
+      return Produced(call, JniEnv::GetEnv()->NewObjectA(clazz, method,
+                                                         jvalues_.data()));
+    }
+
+    return Produced(call, CallMethod(is_static, object, clazz, method,
+                                     signature->second, jvalues_.data()));
+  }
+
+  Outcome Reissue(const RecordedCall& call) {
+    JNIEnv* env = JniEnv::GetEnv();
+    const std::string_view name = call.name;
+
+    if (name == "FindClass") {
+      if (call.args.empty() || call.args[0].kind != RecordedArgKind::kString) {
+        return Outcome::kUnresolved;
+      }
+      return Produced(call, env->FindClass(call.args[0].str.c_str()));
+    }
+    if (name == "GetMethodID" || name == "GetStaticMethodID" ||
+        name == "GetFieldID" || name == "GetStaticFieldID") {
+      return ReissueLookup(call,
+                           name.find(kMethod) != std::string_view::npos,
+                           name.find("Static") != std::string_view::npos);
+    }
+    if (name == "NewObject") {
+      return ReissueCall(call, false, true);
+    }
+
+    const bool is_ref = name == "GetObjectClass" || name == "AllocObject" ||
+                        name == "NewLocalRef" || name == "NewGlobalRef" ||
+                        name == "DeleteLocalRef" || name == "DeleteGlobalRef";
+    if (is_ref) {
+      void* ref;
+      if (call.args.empty() || !Resolve(call.args[0], &ref)) {
+        return Outcome::kUnresolved;
+      }
+
+      auto object = static_cast<jobject>(ref);
+      if (name == "GetObjectClass") {
+        return Produced(call, env->GetObjectClass(object));
+      } else if (name == "AllocObject") {
+        return Produced(call, env->AllocObject(static_cast<jclass>(object)));
+      } else if (name == "NewLocalRef") {
+        return Produced(call, env->NewLocalRef(object));
+      } else if (name == "NewGlobalRef") {
+        return Produced(call, env->NewGlobalRef(object));
+      }
+
+      if (name == "DeleteLocalRef") {
+        env->DeleteLocalRef(object);
+      } else {
+        env->DeleteGlobalRef(object);
+      }
+      handles_.erase(call.args[0].handle);
+
+      return Outcome::kReissued;
+    }
+
+    // e.g. "CallIntMethod" or "CallStaticObjectMethod, Rank 1".  The return
+    // type is taken from the signature.  Nonvirtual calls are skipped.
+    const bool is_call =
+        name.substr(0, kCallPrefix.size()) == kCallPrefix &&
+        name.find(kMethod) != std::string_view::npos &&
+        name.find("Nonvirtual") == std::string_view::npos;
+    if (is_call) {
+      return ReissueCall(
+          call, name.substr(0, kStaticPrefix.size()) == kStaticPrefix, false);
+    }
+
+    return Outcome::kUnsupported;
+  }
+
+  // Recorded handle to replayed handle.
+  std::unordered_map<std::uint64_t, void*> handles_;
+  // Replayed method to its signature.
+  std::unordered_map<jmethodID, std::string> signatures_;
+  // Replayed result of each recorded thread's last call (see `MapResult`).
+  std::unordered_map<std::uint32_t, void*> last_results_;
+  std::vector<jvalue> jvalues_;
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_JNI_HELPER_CALL_REPLAY_H_
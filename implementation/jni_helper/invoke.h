@@ -17,6 +17,7 @@
 #ifndef JNI_BIND_METHOD_INVOKE_H_
 #define JNI_BIND_METHOD_INVOKE_H_
 
+#include <cstddef>
 #include <utility>
 
 #include "jni_env.h"
@@ -26,25 +27,132 @@
 
 namespace jni {
 
-template <typename ReturnType, std::size_t kRank, bool kStatic>
+// `JNIEnv` entry points for an instance call returning |CallT| (objects and
+// arrays of all ranks are returned through `jobject`).
+template <typename CallT>
+struct InstanceCallFns {};
+
+template <>
+struct InstanceCallFns<void> {
+  static constexpr auto kVirtual = &JNIEnv::CallVoidMethod;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualVoidMethod;
+};
+
+template <>
+struct InstanceCallFns<jboolean> {
+  static constexpr auto kVirtual = &JNIEnv::CallBooleanMethod;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualBooleanMethod;
+};
+
+template <>
+struct InstanceCallFns<jbyte> {
+  static constexpr auto kVirtual = &JNIEnv::CallByteMethod;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualByteMethod;
+};
+
+template <>
+struct InstanceCallFns<jchar> {
+  static constexpr auto kVirtual = &JNIEnv::CallCharMethod;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualCharMethod;
+};
+
+template <>
+struct InstanceCallFns<jshort> {
+  static constexpr auto kVirtual = &JNIEnv::CallShortMethod;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualShortMethod;
+};
+
+template <>
+struct InstanceCallFns<jint> {
+  static constexpr auto kVirtual = &JNIEnv::CallIntMethod;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualIntMethod;
+};
+
+template <>
+struct InstanceCallFns<jlong> {
+  static constexpr auto kVirtual = &JNIEnv::CallLongMethod;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualLongMethod;
+};
+
+template <>
+struct InstanceCallFns<jfloat> {
+  static constexpr auto kVirtual = &JNIEnv::CallFloatMethod;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualFloatMethod;
+};
+
+template <>
+struct InstanceCallFns<jdouble> {
+  static constexpr auto kVirtual = &JNIEnv::CallDoubleMethod;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualDoubleMethod;
+};
+
+template <>
+struct InstanceCallFns<jobject> {
+  static constexpr auto kVirtual = &JNIEnv::CallObjectMethod;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualObjectMethod;
+};
+
+// Invokes |method_id| on |object| with `Call<T>Method` or, if |kNonvirtual|,
+// the implementation from |clazz| with `CallNonvirtual<T>Method`.
+template <bool kNonvirtual, typename CallT, typename... Ts>
+inline CallT InstanceCall(jobject object, jclass clazz, jmethodID method_id,
+                          Ts&&... ts) {
+  JNIEnv* env = jni::JniEnv::GetEnv();
+
+  if constexpr (kNonvirtual) {
+    return (env->*InstanceCallFns<CallT>::kNonvirtual)(
+        object, clazz, method_id, std::forward<Ts>(ts)...);
+  } else {
+    return (env->*InstanceCallFns<CallT>::kVirtual)(object, method_id,
+                                                    std::forward<Ts>(ts)...);
+  }
+}
+
+// Trace tags are written for virtual calls ("Call<T>Method..."), non-virtual
+// calls are traced as "CallNonvirtual<T>Method...".
+template <bool kNonvirtual, typename Tag>
+struct NonvirtualCallTag {
+  using type = Tag;
+};
+
+template <char... chars>
+struct NonvirtualCallTag<
+    true, metaprogramming::StringAsType<'C', 'a', 'l', 'l', chars...>> {
+  using type =
+      metaprogramming::StringAsType<'C', 'a', 'l', 'l', 'N', 'o', 'n', 'v',
+                                    'i', 'r', 't', 'u', 'a', 'l', chars...>;
+};
+
+template <bool kNonvirtual, typename NameLambda>
+constexpr auto CallTag(NameLambda name) {
+  return typename NonvirtualCallTag<
+      kNonvirtual, decltype(metaprogramming::LambdaToStr(name))>::type{};
+}
+
+// Instance methods are invoked virtually unless |kNonvirtual| (see
+// `Nonvirtual` and `SuperRef`), in which case |clazz| must declare (or
+// inherit) |method_id| and its implementation is invoked even if |object|
+// overrides it.  |kNonvirtual| is never set for static methods.
+template <typename ReturnType, std::size_t kRank, bool kStatic,
+          bool kNonvirtual = false>
 class InvokeHelper {};
 
 ////////////////////////////////////////////////////////////////////////////////
 // Rank 0 type: void
 //    void is special, but for symmetry it uses rank 0 with primitives.
 ////////////////////////////////////////////////////////////////////////////////
-template <>
-struct InvokeHelper<void, 0, false> {
+template <bool kNonvirtual>
+struct InvokeHelper<void, 0, false, kNonvirtual> {
   template <typename... Ts>
   static void Invoke(jobject object, jclass clazz, jmethodID method_id,
                      Ts&&... ts) {
 #ifdef DRY_RUN
 #else
-    Trace(metaprogramming::LambdaToStr(STR("CallVoidMethod")), object, clazz,
-          method_id, ts...);
+    Trace(CallTag<kNonvirtual>(STR("CallVoidMethod")), object, clazz, method_id,
+          ts...);
 
-    jni::JniEnv::GetEnv()->CallVoidMethod(object, method_id,
-                                          std::forward<Ts>(ts)...);
+    InstanceCall<kNonvirtual, void>(object, clazz, method_id,
+                                    std::forward<Ts>(ts)...);
 #endif  // DRY_RUN
   }
 };
@@ -52,125 +160,176 @@ struct InvokeHelper<void, 0, false> {
 ////////////////////////////////////////////////////////////////////////////////
 // Rank 0 types, i.e. the primitive type itself (e.g. int).
 ////////////////////////////////////////////////////////////////////////////////
-template <>
-struct InvokeHelper<jboolean, 0, false> {
+template <bool kNonvirtual>
+struct InvokeHelper<jboolean, 0, false, kNonvirtual> {
   template <typename... Ts>
   static jboolean Invoke(jobject object, jclass clazz, jmethodID method_id,
                          Ts&&... ts) {
 #ifdef DRY_RUN
     return Fake<jboolean>();
 #else
-    Trace(metaprogramming::LambdaToStr(STR("CallBooleanMethod")), object, clazz,
+    Trace(CallTag<kNonvirtual>(STR("CallBooleanMethod")), object, clazz,
           method_id, ts...);
 
-    return jni::JniEnv::GetEnv()->CallBooleanMethod(object, method_id,
-                                                    std::forward<Ts>(ts)...);
+    return InstanceCall<kNonvirtual, jboolean>(object, clazz, method_id,
+                                               std::forward<Ts>(ts)...);
 #endif  // DRY_RUN
   }
 };
 
-template <>
-struct InvokeHelper<jint, 0, false> {
+template <bool kNonvirtual>
+struct InvokeHelper<jbyte, 0, false, kNonvirtual> {
+  template <typename... Ts>
+  static jbyte Invoke(jobject object, jclass clazz, jmethodID method_id,
+                      Ts&&... ts) {
+    Trace(CallTag<kNonvirtual>(STR("CallByteMethod")), object, clazz, method_id,
+          ts...);
+
+#ifdef DRY_RUN
+    return Fake<jbyte>();
+#else
+    return InstanceCall<kNonvirtual, jbyte>(object, clazz, method_id,
+                                            std::forward<Ts>(ts)...);
+#endif  // DRY_RUN
+  }
+};
+
+template <bool kNonvirtual>
+struct InvokeHelper<jchar, 0, false, kNonvirtual> {
+  template <typename... Ts>
+  static jchar Invoke(jobject object, jclass clazz, jmethodID method_id,
+                      Ts&&... ts) {
+    Trace(CallTag<kNonvirtual>(STR("CallCharMethod")), object, clazz, method_id,
+          ts...);
+
+#ifdef DRY_RUN
+    return Fake<jchar>();
+#else
+    return InstanceCall<kNonvirtual, jchar>(object, clazz, method_id,
+                                            std::forward<Ts>(ts)...);
+#endif  // DRY_RUN
+  }
+};
+
+template <bool kNonvirtual>
+struct InvokeHelper<jshort, 0, false, kNonvirtual> {
+  template <typename... Ts>
+  static jshort Invoke(jobject object, jclass clazz, jmethodID method_id,
+                       Ts&&... ts) {
+    Trace(CallTag<kNonvirtual>(STR("CallShortMethod")), object, clazz,
+          method_id, ts...);
+
+#ifdef DRY_RUN
+    return Fake<jshort>();
+#else
+    return InstanceCall<kNonvirtual, jshort>(object, clazz, method_id,
+                                             std::forward<Ts>(ts)...);
+#endif  // DRY_RUN
+  }
+};
+
+template <bool kNonvirtual>
+struct InvokeHelper<jint, 0, false, kNonvirtual> {
   template <typename... Ts>
   static jint Invoke(jobject object, jclass clazz, jmethodID method_id,
                      Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(STR("CallIntMethod")), object, clazz,
-          method_id, ts...);
+    Trace(CallTag<kNonvirtual>(STR("CallIntMethod")), object, clazz, method_id,
+          ts...);
 
 #ifdef DRY_RUN
     return Fake<jint>();
 #else
-    return jni::JniEnv::GetEnv()->CallIntMethod(object, method_id,
-                                                std::forward<Ts>(ts)...);
+    return InstanceCall<kNonvirtual, jint>(object, clazz, method_id,
+                                           std::forward<Ts>(ts)...);
 #endif  // DRY_RUN
   }
 };
 
-template <>
-struct InvokeHelper<jlong, 0, false> {
+template <bool kNonvirtual>
+struct InvokeHelper<jlong, 0, false, kNonvirtual> {
   template <typename... Ts>
   static jlong Invoke(jobject object, jclass clazz, jmethodID method_id,
                       Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(STR("CallLongMethod")), object, clazz,
-          method_id, ts...);
+    Trace(CallTag<kNonvirtual>(STR("CallLongMethod")), object, clazz, method_id,
+          ts...);
 
 #ifdef DRY_RUN
     return Fake<jlong>();
 #else
-    return jni::JniEnv::GetEnv()->CallLongMethod(object, method_id,
-                                                 std::forward<Ts>(ts)...);
+    return InstanceCall<kNonvirtual, jlong>(object, clazz, method_id,
+                                            std::forward<Ts>(ts)...);
 #endif  // DRY_RUN
   }
 };
 
-template <>
-struct InvokeHelper<jfloat, 0, false> {
+template <bool kNonvirtual>
+struct InvokeHelper<jfloat, 0, false, kNonvirtual> {
   template <typename... Ts>
   static jfloat Invoke(jobject object, jclass clazz, jmethodID method_id,
                        Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(STR("CallFloatMethod")), object, clazz,
+    Trace(CallTag<kNonvirtual>(STR("CallFloatMethod")), object, clazz,
           method_id, ts...);
 
 #ifdef DRY_RUN
     //    return Fake<jfloat>();
     return 123.f;
 #else
-    return jni::JniEnv::GetEnv()->CallFloatMethod(object, method_id,
-                                                  std::forward<Ts>(ts)...);
+    return InstanceCall<kNonvirtual, jfloat>(object, clazz, method_id,
+                                             std::forward<Ts>(ts)...);
 #endif  // DRY_RUN
   }
 };
 
-template <>
-struct InvokeHelper<jdouble, 0, false> {
+template <bool kNonvirtual>
+struct InvokeHelper<jdouble, 0, false, kNonvirtual> {
   template <typename... Ts>
   static jdouble Invoke(jobject object, jclass clazz, jmethodID method_id,
                         Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(STR("CallDoubleMethod")), object, clazz,
+    Trace(CallTag<kNonvirtual>(STR("CallDoubleMethod")), object, clazz,
           method_id, ts...);
 
 #ifdef DRY_RUN
     // return Fake<jdouble>();
     return 123.f;
 #else
-    return jni::JniEnv::GetEnv()->CallDoubleMethod(object, method_id,
-                                                   std::forward<Ts>(ts)...);
+    return InstanceCall<kNonvirtual, jdouble>(object, clazz, method_id,
+                                              std::forward<Ts>(ts)...);
 #endif  // DRY_RUN
   }
 };
 
-template <>
-struct InvokeHelper<jobject, 0, false> {
+template <bool kNonvirtual>
+struct InvokeHelper<jobject, 0, false, kNonvirtual> {
   // This always returns a local reference which should be embedded in type
   // information wherever this is used.
   template <typename... Ts>
   static jobject Invoke(jobject object, jclass clazz, jmethodID method_id,
                         Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(STR("CallObjectMethod")), object, clazz,
+    Trace(CallTag<kNonvirtual>(STR("CallObjectMethod")), object, clazz,
           method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobject>();
 #else
-    return jni::JniEnv::GetEnv()->CallObjectMethod(object, method_id,
-                                                   std::forward<Ts>(ts)...);
+    return TraceResult(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif  // DRY_RUN
   }
 };
 
-template <>
-struct InvokeHelper<jstring, 0, false> {
+template <bool kNonvirtual>
+struct InvokeHelper<jstring, 0, false, kNonvirtual> {
   template <typename... Ts>
   static jobject Invoke(jobject object, jclass clazz, jmethodID method_id,
                         Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(STR("CallObjectMethod")), object, clazz,
+    Trace(CallTag<kNonvirtual>(STR("CallObjectMethod")), object, clazz,
           method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jstring>();
 #else
-    return jni::JniEnv::GetEnv()->CallObjectMethod(object, method_id,
-                                                   std::forward<Ts>(ts)...);
+    return TraceResult(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif  // DRY_RUN
   }
 };
@@ -178,184 +337,194 @@ struct InvokeHelper<jstring, 0, false> {
 ////////////////////////////////////////////////////////////////////////////////
 // Rank 1 types, i.e. single dimension arrays (e.g. int[]).
 ////////////////////////////////////////////////////////////////////////////////
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank == 1), jboolean>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank == 1), jboolean>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jbooleanArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                               Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jbooleanArray), Rank 1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jbooleanArray>();
 #else
-    return static_cast<jbooleanArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jbooleanArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif  // DRY_RUN
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank == 1), jbyte>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank == 1), jbyte>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jbyteArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                            Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jbyteArray), Rank 1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jbyteArray>();
 #else
-    return static_cast<jbyteArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jbyteArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif  // DRY_RUN
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank == 1), jchar>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank == 1), jchar>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jcharArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                            Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jcharArray), Rank 1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jcharArray>();
 #else
-    return static_cast<jcharArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jcharArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif  // DRY_RUN
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank == 1), jshort>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank == 1), jshort>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jshortArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                             Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jshortArray), Rank 1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jshortArray>();
 #else
-    return static_cast<jshortArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jshortArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank == 1), jint>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank == 1), jint>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jintArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                           Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jintArray), Rank 1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jintArray>();
 #else
-    return static_cast<jintArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jintArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank == 1), jlong>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank == 1), jlong>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jlongArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                            Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jlongArray), Rank 1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jlongArray>();
 #else
-    return static_cast<jlongArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jlongArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank == 1), jfloat>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank == 1), jfloat>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jfloatArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                             Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jfloatArray), Rank 1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jfloatArray>();
 #else
-    return static_cast<jfloatArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jfloatArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank == 1), jdouble>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank == 1), jdouble>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jdoubleArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jdoubleArray), Rank 1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jdoubleArray>();
 #else
-    return static_cast<jdoubleArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jdoubleArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank == 1), jarray>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank == 1), jarray>, kRank, false,
+                    kNonvirtual> {
   // Arrays of arrays (which this invoke represents) return object arrays
   // (arrays themselves are objects, ergo object arrays).
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank 1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank == 1), jobject>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank == 1), jobject>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank 1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
@@ -363,183 +532,193 @@ struct InvokeHelper<std::enable_if_t<(kRank == 1), jobject>, kRank, false> {
 ////////////////////////////////////////////////////////////////////////////////
 // Rank 2+ types, i.e. multi-dimension arrays (e.g. int[][], int[][][]).
 ////////////////////////////////////////////////////////////////////////////////
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank > 1), jboolean>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank > 1), jboolean>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank >1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank > 1), jbyte>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank > 1), jbyte>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank >1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank > 1), jchar>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank > 1), jchar>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank >1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank > 1), jshort>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank > 1), jshort>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank >1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank > 1), jint>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank > 1), jint>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank >1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank > 1), jfloat>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank > 1), jfloat>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank >1")),
           object, clazz, method_id, ts...);
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank > 1), jdouble>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank > 1), jdouble>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank >1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank > 1), jlong>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank > 1), jlong>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank >1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank > 1), jarray>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank > 1), jarray>, kRank, false,
+                    kNonvirtual> {
   // Arrays of arrays (which this invoke represents) return object arrays
   // (arrays themselves are objects, ergo object arrays).
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank >1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
 
-template <std::size_t kRank>
-struct InvokeHelper<std::enable_if_t<(kRank > 1), jobject>, kRank, false> {
+template <std::size_t kRank, bool kNonvirtual>
+struct InvokeHelper<std::enable_if_t<(kRank > 1), jobject>, kRank, false,
+                    kNonvirtual> {
   template <typename... Ts>
   static jobjectArray Invoke(jobject object, jclass clazz, jmethodID method_id,
                              Ts&&... ts) {
-    Trace(metaprogramming::LambdaToStr(
+    Trace(CallTag<kNonvirtual>(
               STR("CallObjectMethod (jobjectArray), Rank >1")),
           object, clazz, method_id, ts...);
 
 #ifdef DRY_RUN
     return Fake<jobjectArray>();
 #else
-    return static_cast<jobjectArray>(jni::JniEnv::GetEnv()->CallObjectMethod(
-        object, method_id, std::forward<Ts>(ts)...));
+    return static_cast<jobjectArray>(InstanceCall<kNonvirtual, jobject>(
+        object, clazz, method_id, std::forward<Ts>(ts)...));
 #endif
   }
 };
@@ -195,8 +195,8 @@ struct InvokeHelper<jobject, 0, true> {
 #ifdef DRY_RUN
     return Fake<jobject>();
 #else
-    return jni::JniEnv::GetEnv()->CallStaticObjectMethod(
-        clazz, method_id, std::forward<Ts>(ts)...);
+    return TraceResult(jni::JniEnv::GetEnv()->CallStaticObjectMethod(
+        clazz, method_id, std::forward<Ts>(ts)...));
 #endif  // DRY_RUN
   }
 };
@@ -212,8 +212,8 @@ struct InvokeHelper<jstring, 0, true> {
 #ifdef DRY_RUN
     return Fake<jobject>();
 #else
-    return jni::JniEnv::GetEnv()->CallStaticObjectMethod(
-        clazz, method_id, std::forward<Ts>(ts)...);
+    return TraceResult(jni::JniEnv::GetEnv()->CallStaticObjectMethod(
+        clazz, method_id, std::forward<Ts>(ts)...));
 #endif  // DRY_RUN
   }
 };
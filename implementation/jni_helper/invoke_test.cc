@@ -59,6 +59,15 @@ TEST_F(JniTest, InvokeHelper_InvokesBooleanMethod) {
             true);
 }
 
+TEST_F(JniTest, InvokeHelper_InvokesByteMethod) {
+  EXPECT_CALL(*env_, CallByteMethodV(Fake<jobject>(), Fake<jmethodID>(), _))
+      .WillOnce(Return(12));
+
+  EXPECT_EQ((InvokeHelper<jbyte, 0, false>::Invoke(Fake<jobject>(), nullptr,
+                                                   Fake<jmethodID>(), 1)),
+            12);
+}
+
 TEST_F(JniTest, InvokeHelper_InvokesIntMethod) {
   EXPECT_CALL(*env_, CallIntMethodV(Fake<jobject>(), Fake<jmethodID>(), _))
       .Times(3)
@@ -123,4 +132,22 @@ TEST_F(JniTest, InvokeHelper_InvokesObjectMethod) {
             Fake<jobject>());
 }
 
+TEST_F(JniTest, InvokeHelper_NonvirtualInvokesTheClassImplementation) {
+  EXPECT_CALL(*env_, CallNonvirtualIntMethodV(Fake<jobject>(), Fake<jclass>(),
+                                              Fake<jmethodID>(), _))
+      .WillOnce(Return(123));
+  EXPECT_CALL(*env_, CallNonvirtualObjectMethodV(
+                         Fake<jobject>(), Fake<jclass>(), Fake<jmethodID>(), _))
+      .WillOnce(Return(Fake<jintArray>()));
+  EXPECT_CALL(*env_, CallIntMethodV).Times(0);
+  EXPECT_CALL(*env_, CallObjectMethodV).Times(0);
+
+  EXPECT_EQ((InvokeHelper<jint, 0, false, true>::Invoke(
+                Fake<jobject>(), Fake<jclass>(), Fake<jmethodID>(), 1)),
+            123);
+  EXPECT_EQ((InvokeHelper<jint, 1, false, true>::Invoke(
+                Fake<jobject>(), Fake<jclass>(), Fake<jmethodID>(), 1)),
+            Fake<jintArray>());
+}
+
 }  // namespace
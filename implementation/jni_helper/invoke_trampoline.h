@@ -0,0 +1,115 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_JNI_HELPER_INVOKE_TRAMPOLINE_H_
+#define JNI_BIND_IMPLEMENTATION_JNI_HELPER_INVOKE_TRAMPOLINE_H_
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "invoke.h"
+#include "invoke_static.h"
+#include "out_of_line_helpers.h"
+#include "jni_dep.h"
+#include "metaprogramming/lambda_string.h"
+#include "trace.h"
+
+namespace jni {
+
+// All reference types are passed through varargs as a `jobject`, so they can
+// share a trampoline. Everything else (primitives) is passed as is.
+template <typename T>
+using TrampolineArg_t =
+    std::conditional_t<std::is_convertible_v<std::decay_t<T>, jobject>,
+                       jobject, std::decay_t<T>>;
+
+// Only defined for `InvokeTrampoline` (undefined below so it doesn't leak into
+// user code).
+#if defined(__GNUC__) || defined(__clang__)
+#define JNI_BIND_NOINLINE __attribute__((noinline))
+#else
+#define JNI_BIND_NOINLINE
+#endif
+
+// Out of line entry point for `InvokeHelper`.
+//
+// `InvokeHelper::Invoke` is small and otherwise inlined into every
+// `OverloadRef::Invoke`, i.e. once for every method of every binding. This
+// takes its arguments by value and is never inlined, so every method with the
+// same return type, rank and argument shape shares one copy of the call.
+template <typename ReturnType, std::size_t kRank, bool kStatic,
+          bool kNonvirtual, typename... Ts>
+struct InvokeTrampoline {
+  JNI_BIND_NOINLINE static auto Invoke(jobject object, jclass clazz,
+                                       jmethodID method_id, Ts... ts) {
+    return InvokeHelper<ReturnType, kRank, kStatic, kNonvirtual>::Invoke(
+        object, clazz, method_id, ts...);
+  }
+};
+
+#undef JNI_BIND_NOINLINE
+
+// Routes through `OutOfLineInvoke` if JNI_BIND_OUT_OF_LINE_HELPERS is defined,
+// through `InvokeTrampoline` if JNI_BIND_SHARED_INVOKE_TRAMPOLINES is defined,
+// and otherwise calls `InvokeHelper` directly (the default).
+template <typename ReturnType, std::size_t kRank, bool kStatic,
+          bool kNonvirtual = false>
+struct InvokeDispatch {
+  template <typename... Ts>
+  static auto Invoke(jobject object, jclass clazz, jmethodID method_id,
+                     Ts&&... ts) {
+#if defined(JNI_BIND_OUT_OF_LINE_HELPERS) && !defined(DRY_RUN)
+    using ResultT =
+        decltype(InvokeHelper<ReturnType, kRank, kStatic, kNonvirtual>::Invoke(
+            object, clazz, method_id, std::forward<Ts>(ts)...));
+    using OutOfLineT = OutOfLineInvoke<OutOfLineCall_t<ReturnType, kRank>,
+                                       kStatic, kNonvirtual>;
+
+    // Arguments are only visible here, so calls are traced before they are
+    // handed over. The return type of a replayed call comes from its
+    // signature, so the tags needn't name it.
+    if constexpr (kStatic) {
+      Trace(metaprogramming::LambdaToStr(STR("CallStaticMethod")), clazz,
+            method_id, ts...);
+    } else if constexpr (kNonvirtual) {
+      Trace(metaprogramming::LambdaToStr(STR("CallNonvirtualMethod")), object,
+            clazz, method_id, ts...);
+    } else {
+      Trace(metaprogramming::LambdaToStr(STR("CallMethod")), object, clazz,
+            method_id, ts...);
+    }
+
+    if constexpr (std::is_void_v<ResultT>) {
+      OutOfLineT::Invoke(object, clazz, method_id, ts...);
+    } else {
+      return static_cast<ResultT>(
+          OutOfLineT::Invoke(object, clazz, method_id, ts...));
+    }
+#elif defined(JNI_BIND_SHARED_INVOKE_TRAMPOLINES)
+    return InvokeTrampoline<ReturnType, kRank, kStatic, kNonvirtual,
+                            TrampolineArg_t<Ts>...>::Invoke(object, clazz,
+                                                            method_id, ts...);
+#else
+    return InvokeHelper<ReturnType, kRank, kStatic, kNonvirtual>::Invoke(
+        object, clazz, method_id, std::forward<Ts>(ts)...);
+#endif  // JNI_BIND_SHARED_INVOKE_TRAMPOLINES
+  }
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_JNI_HELPER_INVOKE_TRAMPOLINE_H_
@@ -19,6 +19,7 @@
 #include <type_traits>
 
 #include "get_array_element_result.h"
+#include "implementation/jni_helper/jni_check.h"
 #include "implementation/jni_helper/jni_env.h"
 #include "jni_dep.h"
 #include "metaprogramming/lambda_string.h"
@@ -36,6 +37,37 @@ struct JniArrayHelperBase {
     return jni::JniEnv::GetEnv()->GetArrayLength(array);
 #endif  // DRY_RUN
   }
+
+  // No other JNI calls may be made (and the thread must not block) until the
+  // matching `ReleasePrimitiveArrayCritical`.
+  static inline void* GetPrimitiveArrayCritical(jarray array) {
+    Trace(metaprogramming::LambdaToStr(STR("GetPrimitiveArrayCritical")),
+          array);
+
+    JniCheck::CriticalPinned();
+
+#ifdef DRY_RUN
+    return nullptr;
+#else
+    return jni::JniEnv::GetEnv()->GetPrimitiveArrayCritical(array, nullptr);
+#endif  // DRY_RUN
+  }
+
+  static inline void ReleasePrimitiveArrayCritical(jarray array,
+                                                   void* native_ptr,
+                                                   bool copy_on_completion) {
+    Trace(metaprogramming::LambdaToStr(STR("ReleasePrimitiveArrayCritical")),
+          array, native_ptr, copy_on_completion);
+
+#ifdef DRY_RUN
+#else
+    const jint copy_back_mode = copy_on_completion ? 0 : JNI_ABORT;
+    jni::JniEnv::GetEnv()->ReleasePrimitiveArrayCritical(array, native_ptr,
+                                                         copy_back_mode);
+#endif  // DRY_RUN
+
+    JniCheck::CriticalReleased();
+  }
 };
 
 // Rank 2+ arrays all behave like object arrays.
@@ -124,6 +156,30 @@ struct JniArrayHelper<jboolean, 1> : public JniArrayHelperBase {
     const jint copy_back_mode = copy_on_completion ? 0 : JNI_ABORT;
     jni::JniEnv::GetEnv()->ReleaseBooleanArrayElements(
         static_cast<jbooleanArray>(array), native_ptr, copy_back_mode);
+#endif  // DRY_RUN
+  }
+
+  static inline void GetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, jboolean* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("GetBooleanArrayRegion")), array,
+          start, len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->GetBooleanArrayRegion(
+        static_cast<jbooleanArray>(array), start, len, buf);
+#endif  // DRY_RUN
+  }
+
+  static inline void SetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, const jboolean* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("SetBooleanArrayRegion")), array,
+          start, len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->SetBooleanArrayRegion(
+        static_cast<jbooleanArray>(array), start, len, buf);
 #endif  // DRY_RUN
   }
 };
@@ -168,6 +224,30 @@ struct JniArrayHelper<jbyte, 1> : public JniArrayHelperBase {
     const jint copy_back_mode = copy_on_completion ? 0 : JNI_ABORT;
     jni::JniEnv::GetEnv()->ReleaseByteArrayElements(
         static_cast<jbyteArray>(array), native_ptr, copy_back_mode);
+#endif  // DRY_RUN
+  }
+
+  static inline void GetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, jbyte* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("GetByteArrayRegion")), array, start,
+          len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->GetByteArrayRegion(
+        static_cast<jbyteArray>(array), start, len, buf);
+#endif  // DRY_RUN
+  }
+
+  static inline void SetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, const jbyte* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("SetByteArrayRegion")), array, start,
+          len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->SetByteArrayRegion(
+        static_cast<jbyteArray>(array), start, len, buf);
 #endif  // DRY_RUN
   }
 };
@@ -212,6 +292,30 @@ struct JniArrayHelper<jchar, 1> : public JniArrayHelperBase {
     const jint copy_back_mode = copy_on_completion ? 0 : JNI_ABORT;
     jni::JniEnv::GetEnv()->ReleaseCharArrayElements(
         static_cast<jcharArray>(array), native_ptr, copy_back_mode);
+#endif  // DRY_RUN
+  }
+
+  static inline void GetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, jchar* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("GetCharArrayRegion")), array, start,
+          len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->GetCharArrayRegion(
+        static_cast<jcharArray>(array), start, len, buf);
+#endif  // DRY_RUN
+  }
+
+  static inline void SetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, const jchar* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("SetCharArrayRegion")), array, start,
+          len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->SetCharArrayRegion(
+        static_cast<jcharArray>(array), start, len, buf);
 #endif  // DRY_RUN
   }
 };
@@ -256,6 +360,30 @@ struct JniArrayHelper<jshort, 1> : public JniArrayHelperBase {
     const jint copy_back_mode = copy_on_completion ? 0 : JNI_ABORT;
     jni::JniEnv::GetEnv()->ReleaseShortArrayElements(
         static_cast<jshortArray>(array), native_ptr, copy_back_mode);
+#endif  // DRY_RUN
+  }
+
+  static inline void GetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, jshort* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("GetShortArrayRegion")), array,
+          start, len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->GetShortArrayRegion(
+        static_cast<jshortArray>(array), start, len, buf);
+#endif  // DRY_RUN
+  }
+
+  static inline void SetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, const jshort* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("SetShortArrayRegion")), array,
+          start, len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->SetShortArrayRegion(
+        static_cast<jshortArray>(array), start, len, buf);
 #endif  // DRY_RUN
   }
 };
@@ -300,6 +428,30 @@ struct JniArrayHelper<jint, 1> : public JniArrayHelperBase {
     const jint copy_back_mode = copy_on_completion ? 0 : JNI_ABORT;
     jni::JniEnv::GetEnv()->ReleaseIntArrayElements(
         static_cast<jintArray>(array), native_ptr, copy_back_mode);
+#endif  // DRY_RUN
+  }
+
+  static inline void GetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, jint* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("GetIntArrayRegion")), array, start,
+          len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->GetIntArrayRegion(
+        static_cast<jintArray>(array), start, len, buf);
+#endif  // DRY_RUN
+  }
+
+  static inline void SetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, const jint* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("SetIntArrayRegion")), array, start,
+          len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->SetIntArrayRegion(
+        static_cast<jintArray>(array), start, len, buf);
 #endif  // DRY_RUN
   }
 };
@@ -343,6 +495,30 @@ struct JniArrayHelper<jlong, 1> : public JniArrayHelperBase {
     const jint copy_back_mode = copy_on_completion ? 0 : JNI_ABORT;
     jni::JniEnv::GetEnv()->ReleaseLongArrayElements(
         static_cast<jlongArray>(array), native_ptr, copy_back_mode);
+#endif  // DRY_RUN
+  }
+
+  static inline void GetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, jlong* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("GetLongArrayRegion")), array, start,
+          len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->GetLongArrayRegion(
+        static_cast<jlongArray>(array), start, len, buf);
+#endif  // DRY_RUN
+  }
+
+  static inline void SetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, const jlong* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("SetLongArrayRegion")), array, start,
+          len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->SetLongArrayRegion(
+        static_cast<jlongArray>(array), start, len, buf);
 #endif  // DRY_RUN
   }
 };
@@ -385,6 +561,30 @@ struct JniArrayHelper<jfloat, 1> : public JniArrayHelperBase {
     jni::JniEnv::GetEnv()->ReleaseFloatArrayElements(
         static_cast<jfloatArray>(array), native_ptr, copy_back_mode);
   }
+
+  static inline void GetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, jfloat* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("GetFloatArrayRegion")), array,
+          start, len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->GetFloatArrayRegion(
+        static_cast<jfloatArray>(array), start, len, buf);
+#endif  // DRY_RUN
+  }
+
+  static inline void SetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, const jfloat* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("SetFloatArrayRegion")), array,
+          start, len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->SetFloatArrayRegion(
+        static_cast<jfloatArray>(array), start, len, buf);
+#endif  // DRY_RUN
+  }
 };
 
 template <>
@@ -427,6 +627,30 @@ struct JniArrayHelper<jdouble, 1> : public JniArrayHelperBase {
     const jint copy_back_mode = copy_on_completion ? 0 : JNI_ABORT;
     jni::JniEnv::GetEnv()->ReleaseDoubleArrayElements(
         static_cast<jdoubleArray>(array), native_ptr, copy_back_mode);
+#endif  // DRY_RUN
+  }
+
+  static inline void GetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, jdouble* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("GetDoubleArrayRegion")), array,
+          start, len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->GetDoubleArrayRegion(
+        static_cast<jdoubleArray>(array), start, len, buf);
+#endif  // DRY_RUN
+  }
+
+  static inline void SetArrayRegion(jarray array, std::size_t start,
+                                    std::size_t len, const jdouble* buf) {
+    Trace(metaprogramming::LambdaToStr(STR("SetDoubleArrayRegion")), array,
+          start, len, buf);
+
+#ifdef DRY_RUN
+#else
+    jni::JniEnv::GetEnv()->SetDoubleArrayRegion(
+        static_cast<jdoubleArray>(array), start, len, buf);
 #endif  // DRY_RUN
   }
 };
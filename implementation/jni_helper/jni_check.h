@@ -0,0 +1,176 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_JNI_HELPER_JNI_CHECK_H_
+#define JNI_BIND_IMPLEMENTATION_JNI_HELPER_JNI_CHECK_H_
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <thread>  // NOLINT
+
+#include "implementation/jni_helper/jni_env.h"
+#include "jni_dep.h"
+#include "metaprogramming/lambda_string.h"
+
+namespace jni {
+
+// Receives a description of the misuse. The default prints it and aborts.
+using JniCheckFailureHandler = void (*)(const char* message);
+
+// A lightweight stand in for `-Xcheck:jni` covering the mistakes JNI Bind can
+// see from inside its own wrappers.  Define JNI_BIND_ENABLE_CHECKS to enable
+// (otherwise every check compiles away).  Checks are:
+//
+//   - Local references (`LocalObject`, `LocalArray`, `ArrayView`) used, moved
+//     or released on a thread other than the one that created them.
+//   - Any JNI call while a critical pin is held on the thread.
+//   - Any JNI call with an exception pending, other than those the JNI spec
+//     permits (`Exception*`, `Delete*Ref`, `Release*`, `PopLocalFrame`).
+//   - Any JNI call after `ThreadGuard` detached the thread.
+//
+// Each check is a thread local read, a thread id comparison, or (for pending
+// exceptions) `ExceptionCheck`, so they are cheap enough to leave enabled in
+// canaries.  Which calls are exempt is decided at compile time.
+class JniCheck {
+ public:
+  static constexpr bool kEnabled =
+#ifdef JNI_BIND_ENABLE_CHECKS
+      true;
+#else
+      false;
+#endif  // JNI_BIND_ENABLE_CHECKS
+
+  static void SetFailureHandler(JniCheckFailureHandler handler) {
+    failure_handler_ = handler;
+  }
+
+  // Reports |check| (with the JNI call |name| if non-empty).
+  static void Fail(const char* check, std::string_view name = {}) {
+    char message[256];
+    std::snprintf(message, sizeof(message), "%s%s%.*s", check,
+                  name.empty() ? "" : ": ", static_cast<int>(name.size()),
+                  name.data());
+    failure_handler_(message);
+  }
+
+  // Called before every JNI call JNI Bind makes (see `Trace`).
+  template <char... chars>
+  static void BeforeCall(metaprogramming::StringAsType<chars...>) {
+    if constexpr (kEnabled) {
+      constexpr std::string_view kName =
+          metaprogramming::StringAsType<chars...>::chars_as_sv;
+
+      if (detached_) {
+        Fail("JNI call after ThreadGuard detached this thread", kName);
+      }
+
+      if constexpr (!IsPermittedInCritical(kName)) {
+        if (critical_pins_ != 0) {
+          Fail("JNI call while a critical pin is held", kName);
+        }
+      }
+
+      if constexpr (!IsPermittedWithPendingException(kName)) {
+        JNIEnv* env = JniEnv::GetEnv();
+        if (env != nullptr && critical_pins_ == 0 && env->ExceptionCheck()) {
+          Fail("JNI call with a pending exception", kName);
+        }
+      }
+    }
+  }
+
+  static void CriticalPinned() {
+    if constexpr (kEnabled) {
+      ++critical_pins_;
+    }
+  }
+
+  static void CriticalReleased() {
+    if constexpr (kEnabled) {
+      --critical_pins_;
+    }
+  }
+
+  static void Attached() {
+    if constexpr (kEnabled) {
+      detached_ = false;
+    }
+  }
+
+  static void Detached() {
+    if constexpr (kEnabled) {
+      detached_ = true;
+    }
+  }
+
+ private:
+  static constexpr bool StartsWith(std::string_view name,
+                                   std::string_view prefix) {
+    return name.substr(0, prefix.size()) == prefix;
+  }
+
+  static constexpr bool IsPermittedInCritical(std::string_view name) {
+    return name == "GetPrimitiveArrayCritical" ||
+           name == "ReleasePrimitiveArrayCritical";
+  }
+
+  static constexpr bool IsPermittedWithPendingException(std::string_view name) {
+    return StartsWith(name, "Exception") || StartsWith(name, "Delete") ||
+           StartsWith(name, "Release") || name == "PopLocalFrame" ||
+           name == "PushLocalFrame";
+  }
+
+  static void DefaultFailureHandler(const char* message) {
+    std::fprintf(stderr, "JNI Bind check failed: %s\n", message);
+    std::abort();
+  }
+
+  static inline JniCheckFailureHandler failure_handler_ =
+      &DefaultFailureHandler;
+  static inline thread_local std::size_t critical_pins_ = 0;
+  static inline thread_local bool detached_ = false;
+};
+
+// Records the thread a local reference belongs to.  A default constructed
+// owner belongs to no thread (e.g. globals) and is never checked.  Empty
+// unless checks are enabled.
+template <bool kEnabled = JniCheck::kEnabled>
+class JniCheckThreadOwner {
+ protected:
+  void ClaimThread() {}
+  void CheckThread(const char*) const {}
+};
+
+template <>
+class JniCheckThreadOwner<true> {
+ protected:
+  void ClaimThread() { owner_ = std::this_thread::get_id(); }
+
+  void CheckThread(const char* check) const {
+    if (owner_ != std::thread::id{} && owner_ != std::this_thread::get_id()) {
+      JniCheck::Fail(check);
+    }
+  }
+
+ private:
+  std::thread::id owner_;
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_JNI_HELPER_JNI_CHECK_H_
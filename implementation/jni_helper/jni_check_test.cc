@@ -0,0 +1,144 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "implementation/jni_helper/jni_check.h"
+
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::AdoptLocal;
+using ::jni::Class;
+using ::jni::Fake;
+using ::jni::JniCheck;
+using ::jni::LocalArray;
+using ::jni::LocalObject;
+using ::jni::Method;
+using ::jni::Params;
+using ::jni::ThreadGuard;
+using ::jni::test::JniTest;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::Return;
+
+static_assert(JniCheck::kEnabled);
+
+static constexpr Class kClass{"kClass", Method{"Foo", jni::Return{}, Params{}}};
+
+std::vector<std::string>& Failures() {
+  static auto* failures = new std::vector<std::string>{};
+  return *failures;
+}
+
+class JniCheckTest : public JniTest {
+ public:
+  void SetUp() override {
+    JniTest::SetUp();
+    Failures().clear();
+    JniCheck::SetFailureHandler(
+        +[](const char* message) { Failures().emplace_back(message); });
+  }
+};
+
+TEST_F(JniCheckTest, CorrectUsageReportsNothing) {
+  LocalObject<kClass> obj{AdoptLocal{}, Fake<jobject>()};
+  obj("Foo");
+
+  EXPECT_THAT(Failures(), IsEmpty());
+}
+
+TEST_F(JniCheckTest, ReportsCallWithPendingException) {
+  ON_CALL(*env_, ExceptionCheck).WillByDefault(Return(JNI_TRUE));
+
+  LocalObject<kClass> obj{AdoptLocal{}, Fake<jobject>()};
+  obj("Foo");
+
+  EXPECT_THAT(Failures(), testing::Contains(HasSubstr("pending exception")));
+}
+
+TEST_F(JniCheckTest, PermitsDeleteWithPendingException) {
+  ON_CALL(*env_, ExceptionCheck).WillByDefault(Return(JNI_TRUE));
+
+  { LocalObject<kClass> obj{AdoptLocal{}, Fake<jobject>()}; }
+
+  EXPECT_THAT(Failures(), IsEmpty());
+}
+
+TEST_F(JniCheckTest, ReportsLocalUsedOnAnotherThread) {
+  LocalObject<kClass> obj{AdoptLocal{}, Fake<jobject>()};
+
+  std::thread worker{[&] {
+    ThreadGuard thread_guard{};
+    obj("Foo");
+  }};
+  worker.join();
+
+  EXPECT_THAT(Failures(),
+              ElementsAre(HasSubstr("Local reference used on another thread")));
+}
+
+TEST_F(JniCheckTest, ReportsCallWhileCriticalPinHeld) {
+  LocalArray<jint> array{AdoptLocal{}, Fake<jintArray>()};
+
+  {
+    jni::kernels::CriticalArray<jint> pinned{static_cast<jintArray>(array)};
+    LocalObject<kClass> obj{AdoptLocal{}, Fake<jobject>()};
+    obj("Foo");
+  }
+
+  EXPECT_THAT(Failures(),
+              testing::Contains(HasSubstr("critical pin is held")));
+}
+
+TEST_F(JniCheckTest, DotReadsLengthsBeforePinningEitherArray) {
+  LocalArray<jint> lhs{AdoptLocal{}, Fake<jintArray>(1)};
+  LocalArray<jint> rhs{AdoptLocal{}, Fake<jintArray>(2)};
+
+  jni::kernels::Dot(lhs, rhs);
+
+  EXPECT_THAT(Failures(), IsEmpty());
+}
+
+TEST_F(JniCheckTest, PermitsCallsAfterCriticalPinReleased) {
+  LocalArray<jint> array{AdoptLocal{}, Fake<jintArray>()};
+  { jni::kernels::CriticalArray<jint> pinned{static_cast<jintArray>(array)}; }
+
+  LocalObject<kClass> obj{AdoptLocal{}, Fake<jobject>()};
+  obj("Foo");
+
+  EXPECT_THAT(Failures(), IsEmpty());
+}
+
+TEST_F(JniCheckTest, ReportsCallAfterDetach) {
+  std::thread worker{[&] {
+    ThreadGuard thread_guard{};
+    JniCheck::Detached();
+    jni::JniHelper::GetObjectClass(Fake<jobject>());
+  }};
+  worker.join();
+
+  EXPECT_THAT(Failures(), ElementsAre(HasSubstr("after ThreadGuard detached")));
+}
+
+}  // namespace
@@ -24,6 +24,7 @@ namespace jni {
 template <const auto& jvm_v_>
 class JvmRef;
 class ThreadGuard;
+struct NativeEntryEnv;
 
 // This class represents a static accessor for a ::JNIEnv*.
 //
@@ -51,6 +52,7 @@ class JniEnv {
   template <const auto& jvm_v_>
   friend class JvmRef;
   friend class ThreadGuard;
+  friend struct NativeEntryEnv;
 
   static inline void SetEnv(JNIEnv* env) { env_ = env; }
 
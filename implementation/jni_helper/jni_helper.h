@@ -58,10 +58,45 @@ class JniHelper {
   static inline jfieldID GetStaticFieldID(jclass clazz, const char* field_name,
                                           const char* field_signature);
 
+  // Defines a class from .class file bytes into `loader` (which may be null).
+  // Returns a local, or null (with a pending exception) on failure.
+  static jclass DefineClass(const char* name, jobject loader, const jbyte* buf,
+                            jsize len);
+
+  // Binds native implementations to `clazz`. 0 is success.
+  static jint RegisterNatives(jclass clazz, const JNINativeMethod* methods,
+                              jint num_methods);
+
   // Strings.
   static const char* GetStringUTFChars(jstring str);
 
   static void ReleaseStringUTFChars(jstring str, const char* chars);
+
+  // Length of |str| in UTF-16 code units.
+  static jsize GetStringLength(jstring str);
+
+  // Length of |str| in modified UTF-8 bytes (excluding the terminator).
+  static jsize GetStringUTFLength(jstring str);
+
+  // Copies |len| UTF-16 code units from |start| as modified UTF-8 into |buf|,
+  // which must hold `GetStringUTFLength` + 1 bytes.
+  static void GetStringUTFRegion(jstring str, jsize start, jsize len,
+                                 char* buf);
+
+  // Local frames. 0 is success.
+  static jint PushLocalFrame(jint capacity);
+
+  // Pops the current frame, returning |result| as a local of the prior frame.
+  static jobject PopLocalFrame(jobject result);
+
+  // True if both refer to the same object (or a weak ref has been cleared and
+  // the other is null).
+  static bool IsSameObject(jobject lhs, jobject rhs);
+
+  // Weak globals don't prevent collection. See `IsSameObject`.
+  static jweak NewWeakGlobalRef(jobject object);
+
+  static void DeleteWeakGlobalRef(jweak object);
 };
 
 //==============================================================================
@@ -84,10 +119,10 @@ inline jclass JniHelper::FindClass(const char* name) {
   if (!jclass_from_thread_loader && FallbackLoader() != nullptr) {
     jni::JniEnv::GetEnv()->ExceptionClear();
 
-    return FindClassFallback(name);
+    return TraceResult(FindClassFallback(name));
   }
 
-  return jclass_from_thread_loader;
+  return TraceResult(jclass_from_thread_loader);
 #endif  // DRY_RUN
 }
 
@@ -97,7 +132,7 @@ inline jclass JniHelper::GetObjectClass(jobject object) {
 #ifdef DRY_RUN
   return Fake<jclass>();
 #else
-  return jni::JniEnv::GetEnv()->GetObjectClass(object);
+  return TraceResult(jni::JniEnv::GetEnv()->GetObjectClass(object));
 #endif  // DRY_RUN
 }
 
@@ -109,8 +144,8 @@ jmethodID JniHelper::GetMethodID(jclass clazz, const char* method_name,
 #ifdef DRY_RUN
   return Fake<jmethodID>();
 #else
-  return jni::JniEnv::GetEnv()->GetMethodID(clazz, method_name,
-                                            method_signature);
+  return TraceResult(jni::JniEnv::GetEnv()->GetMethodID(clazz, method_name,
+                                                        method_signature));
 #endif  // DRY_RUN
 }
 
@@ -122,8 +157,8 @@ jmethodID JniHelper::GetStaticMethodID(jclass clazz, const char* method_name,
 #ifdef DRY_RUN
   return Fake<jmethodID>();
 #else
-  return jni::JniEnv::GetEnv()->GetStaticMethodID(clazz, method_name,
-                                                  method_signature);
+  return TraceResult(jni::JniEnv::GetEnv()->GetStaticMethodID(
+      clazz, method_name, method_signature));
 #endif  // DRY_RUN
 }
 
@@ -135,7 +170,7 @@ jfieldID JniHelper::GetFieldID(jclass clazz, const char* name,
 #ifdef DRY_RUN
   return Fake<jfieldID>();
 #else
-  return jni::JniEnv::GetEnv()->GetFieldID(clazz, name, signature);
+  return TraceResult(jni::JniEnv::GetEnv()->GetFieldID(clazz, name, signature));
 #endif  // DRY_RUN
 }
 
@@ -147,7 +182,32 @@ jfieldID JniHelper::GetStaticFieldID(jclass clazz, const char* name,
 #ifdef DRY_RUN
   return Fake<jfieldID>();
 #else
-  return jni::JniEnv::GetEnv()->GetStaticFieldID(clazz, name, signature);
+  return TraceResult(
+      jni::JniEnv::GetEnv()->GetStaticFieldID(clazz, name, signature));
+#endif  // DRY_RUN
+}
+
+inline jclass JniHelper::DefineClass(const char* name, jobject loader,
+                                     const jbyte* buf, jsize len) {
+  Trace(metaprogramming::LambdaToStr(STR("DefineClass")), name, loader, len);
+
+#ifdef DRY_RUN
+  return Fake<jclass>();
+#else
+  return jni::JniEnv::GetEnv()->DefineClass(name, loader, buf, len);
+#endif  // DRY_RUN
+}
+
+inline jint JniHelper::RegisterNatives(jclass clazz,
+                                       const JNINativeMethod* methods,
+                                       jint num_methods) {
+  Trace(metaprogramming::LambdaToStr(STR("RegisterNatives")), clazz,
+        num_methods);
+
+#ifdef DRY_RUN
+  return 0;
+#else
+  return jni::JniEnv::GetEnv()->RegisterNatives(clazz, methods, num_methods);
 #endif  // DRY_RUN
 }
 
@@ -175,6 +235,86 @@ inline void JniHelper::ReleaseStringUTFChars(jstring str, const char* chars) {
 #endif  // DRY_RUN
 }
 
+inline jsize JniHelper::GetStringLength(jstring str) {
+  Trace(metaprogramming::LambdaToStr(STR("GetStringLength")), str);
+
+#ifdef DRY_RUN
+  return 0;
+#else
+  return jni::JniEnv::GetEnv()->GetStringLength(str);
+#endif  // DRY_RUN
+}
+
+inline jsize JniHelper::GetStringUTFLength(jstring str) {
+  Trace(metaprogramming::LambdaToStr(STR("GetStringUTFLength")), str);
+
+#ifdef DRY_RUN
+  return 0;
+#else
+  return jni::JniEnv::GetEnv()->GetStringUTFLength(str);
+#endif  // DRY_RUN
+}
+
+inline void JniHelper::GetStringUTFRegion(jstring str, jsize start, jsize len,
+                                          char* buf) {
+  Trace(metaprogramming::LambdaToStr(STR("GetStringUTFRegion")), str, start,
+        len, buf);
+
+#ifdef DRY_RUN
+#else
+  jni::JniEnv::GetEnv()->GetStringUTFRegion(str, start, len, buf);
+#endif  // DRY_RUN
+}
+
+inline jint JniHelper::PushLocalFrame(jint capacity) {
+  Trace(metaprogramming::LambdaToStr(STR("PushLocalFrame")), capacity);
+
+#ifdef DRY_RUN
+  return 0;
+#else
+  return jni::JniEnv::GetEnv()->PushLocalFrame(capacity);
+#endif  // DRY_RUN
+}
+
+inline jobject JniHelper::PopLocalFrame(jobject result) {
+  Trace(metaprogramming::LambdaToStr(STR("PopLocalFrame")), result);
+
+#ifdef DRY_RUN
+  return result;
+#else
+  return jni::JniEnv::GetEnv()->PopLocalFrame(result);
+#endif  // DRY_RUN
+}
+
+inline bool JniHelper::IsSameObject(jobject lhs, jobject rhs) {
+  Trace(metaprogramming::LambdaToStr(STR("IsSameObject")), lhs, rhs);
+
+#ifdef DRY_RUN
+  return lhs == rhs;
+#else
+  return jni::JniEnv::GetEnv()->IsSameObject(lhs, rhs) == JNI_TRUE;
+#endif  // DRY_RUN
+}
+
+inline jweak JniHelper::NewWeakGlobalRef(jobject object) {
+  Trace(metaprogramming::LambdaToStr(STR("NewWeakGlobalRef")), object);
+
+#ifdef DRY_RUN
+  return object;
+#else
+  return jni::JniEnv::GetEnv()->NewWeakGlobalRef(object);
+#endif  // DRY_RUN
+}
+
+inline void JniHelper::DeleteWeakGlobalRef(jweak object) {
+  Trace(metaprogramming::LambdaToStr(STR("DeleteWeakGlobalRef")), object);
+
+#ifdef DRY_RUN
+#else
+  jni::JniEnv::GetEnv()->DeleteWeakGlobalRef(object);
+#endif  // DRY_RUN
+}
+
 }  // namespace jni
 
 #endif  // JNI_BIND_JNI_HELPER_JNI_HELPER_H_
@@ -52,7 +52,8 @@ struct LifecycleLocalBase {
 #ifdef DRY_RUN
     return Fake<Span>();
 #else
-    return static_cast<Span>(JniEnv::GetEnv()->NewLocalRef(object));
+    return static_cast<Span>(
+        TraceResult(JniEnv::GetEnv()->NewLocalRef(object)));
 #endif  // DRY_RUN
   }
 };
@@ -73,7 +74,7 @@ struct LifecycleGlobalBase {
 #ifdef DRY_RUN
     jobject ret = Fake<jobject>();
 #else
-    jobject ret = JniEnv::GetEnv()->NewGlobalRef(object);
+    jobject ret = TraceResult(JniEnv::GetEnv()->NewGlobalRef(object));
 #endif  // DRY_RUN
 
     Trace(metaprogramming::LambdaToStr(STR("DeleteLocalRef")), object);
@@ -101,7 +102,8 @@ struct LifecycleGlobalBase {
 #ifdef DRY_RUN
     return Fake<Span>();
 #else
-    return static_cast<Span>(JniEnv::GetEnv()->NewGlobalRef(object));
+    return static_cast<Span>(
+        TraceResult(JniEnv::GetEnv()->NewGlobalRef(object)));
 #endif  // DRY_RUN
   }
 };
@@ -35,7 +35,19 @@ struct LifecycleHelper<jobject, LifecycleType::LOCAL>
 #ifdef DRY_RUN
     return Fake<jobject>();
 #else
-    return JniEnv::GetEnv()->NewObject(clazz, ctor_method, ctor_args...);
+    return TraceResult(
+        JniEnv::GetEnv()->NewObject(clazz, ctor_method, ctor_args...));
+#endif  // DRY_RUN
+  }
+
+  // Allocates an object without running any constructor.
+  static inline jobject Allocate(jclass clazz) {
+    Trace(metaprogramming::LambdaToStr(STR("AllocObject")), clazz);
+
+#ifdef DRY_RUN
+    return Fake<jobject>();
+#else
+    return TraceResult(JniEnv::GetEnv()->AllocObject(clazz));
 #endif  // DRY_RUN
   }
 };
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "implementation/jni_helper/out_of_line_helpers.h"
+
+#include <cstdarg>
+#include <type_traits>
+#include <utility>
+
+#include "implementation/jni_helper/field_value.h"
+#include "implementation/jni_helper/jni_env.h"
+#include "implementation/jni_helper/static_field_value.h"
+#include "jni_dep.h"
+
+namespace jni {
+namespace {
+
+// `JNIEnv` va_list entry points for a call returning |CallT|.
+template <typename CallT>
+struct CallVFns {};
+
+template <>
+struct CallVFns<void> {
+  static constexpr auto kVirtual = &JNIEnv::CallVoidMethodV;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualVoidMethodV;
+  static constexpr auto kStatic = &JNIEnv::CallStaticVoidMethodV;
+};
+
+template <>
+struct CallVFns<jboolean> {
+  static constexpr auto kVirtual = &JNIEnv::CallBooleanMethodV;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualBooleanMethodV;
+  static constexpr auto kStatic = &JNIEnv::CallStaticBooleanMethodV;
+};
+
+template <>
+struct CallVFns<jbyte> {
+  static constexpr auto kVirtual = &JNIEnv::CallByteMethodV;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualByteMethodV;
+  static constexpr auto kStatic = &JNIEnv::CallStaticByteMethodV;
+};
+
+template <>
+struct CallVFns<jchar> {
+  static constexpr auto kVirtual = &JNIEnv::CallCharMethodV;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualCharMethodV;
+  static constexpr auto kStatic = &JNIEnv::CallStaticCharMethodV;
+};
+
+template <>
+struct CallVFns<jshort> {
+  static constexpr auto kVirtual = &JNIEnv::CallShortMethodV;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualShortMethodV;
+  static constexpr auto kStatic = &JNIEnv::CallStaticShortMethodV;
+};
+
+template <>
+struct CallVFns<jint> {
+  static constexpr auto kVirtual = &JNIEnv::CallIntMethodV;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualIntMethodV;
+  static constexpr auto kStatic = &JNIEnv::CallStaticIntMethodV;
+};
+
+template <>
+struct CallVFns<jlong> {
+  static constexpr auto kVirtual = &JNIEnv::CallLongMethodV;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualLongMethodV;
+  static constexpr auto kStatic = &JNIEnv::CallStaticLongMethodV;
+};
+
+template <>
+struct CallVFns<jfloat> {
+  static constexpr auto kVirtual = &JNIEnv::CallFloatMethodV;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualFloatMethodV;
+  static constexpr auto kStatic = &JNIEnv::CallStaticFloatMethodV;
+};
+
+template <>
+struct CallVFns<jdouble> {
+  static constexpr auto kVirtual = &JNIEnv::CallDoubleMethodV;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualDoubleMethodV;
+  static constexpr auto kStatic = &JNIEnv::CallStaticDoubleMethodV;
+};
+
+template <>
+struct CallVFns<jobject> {
+  static constexpr auto kVirtual = &JNIEnv::CallObjectMethodV;
+  static constexpr auto kNonvirtual = &JNIEnv::CallNonvirtualObjectMethodV;
+  static constexpr auto kStatic = &JNIEnv::CallStaticObjectMethodV;
+};
+
+template <typename CallT, bool kStatic, bool kNonvirtual>
+CallT CallV(jobject object, jclass clazz, jmethodID method_id, va_list args) {
+  JNIEnv* env = JniEnv::GetEnv();
+
+  if constexpr (kStatic) {
+    return (env->*CallVFns<CallT>::kStatic)(clazz, method_id, args);
+  } else if constexpr (kNonvirtual) {
+    return (env->*CallVFns<CallT>::kNonvirtual)(object, clazz, method_id,
+                                                args);
+  } else {
+    return (env->*CallVFns<CallT>::kVirtual)(object, method_id, args);
+  }
+}
+
+}  // namespace
+
+template <typename CallT, bool kStatic, bool kNonvirtual>
+CallT OutOfLineInvoke<CallT, kStatic, kNonvirtual>::Invoke(jobject object,
+                                                         jclass clazz,
+                                                         jmethodID method_id,
+                                                         ...) {
+  va_list args;
+  va_start(args, method_id);
+
+  if constexpr (std::is_void_v<CallT>) {
+    CallV<CallT, kStatic, kNonvirtual>(object, clazz, method_id, args);
+    va_end(args);
+  } else {
+    CallT ret =
+        CallV<CallT, kStatic, kNonvirtual>(object, clazz, method_id, args);
+    va_end(args);
+
+    return ret;
+  }
+}
+
+template <typename T, bool kStatic>
+T OutOfLineField<T, kStatic>::GetValue(SelfT self, jfieldID field_id) {
+  return FieldHelper<T, 0, kStatic>::GetValue(self, field_id);
+}
+
+template <typename T, bool kStatic>
+void OutOfLineField<T, kStatic>::SetValue(SelfT self, jfieldID field_id,
+                                          T value) {
+  FieldHelper<T, 0, kStatic>::SetValue(self, field_id, std::move(value));
+}
+
+// Every call type, and every primitive field type.
+template struct OutOfLineInvoke<void, false, false>;
+template struct OutOfLineInvoke<void, false, true>;
+template struct OutOfLineInvoke<void, true, false>;
+template struct OutOfLineInvoke<jboolean, false, false>;
+template struct OutOfLineInvoke<jboolean, false, true>;
+template struct OutOfLineInvoke<jboolean, true, false>;
+template struct OutOfLineInvoke<jbyte, false, false>;
+template struct OutOfLineInvoke<jbyte, false, true>;
+template struct OutOfLineInvoke<jbyte, true, false>;
+template struct OutOfLineInvoke<jchar, false, false>;
+template struct OutOfLineInvoke<jchar, false, true>;
+template struct OutOfLineInvoke<jchar, true, false>;
+template struct OutOfLineInvoke<jshort, false, false>;
+template struct OutOfLineInvoke<jshort, false, true>;
+template struct OutOfLineInvoke<jshort, true, false>;
+template struct OutOfLineInvoke<jint, false, false>;
+template struct OutOfLineInvoke<jint, false, true>;
+template struct OutOfLineInvoke<jint, true, false>;
+template struct OutOfLineInvoke<jlong, false, false>;
+template struct OutOfLineInvoke<jlong, false, true>;
+template struct OutOfLineInvoke<jlong, true, false>;
+template struct OutOfLineInvoke<jfloat, false, false>;
+template struct OutOfLineInvoke<jfloat, false, true>;
+template struct OutOfLineInvoke<jfloat, true, false>;
+template struct OutOfLineInvoke<jdouble, false, false>;
+template struct OutOfLineInvoke<jdouble, false, true>;
+template struct OutOfLineInvoke<jdouble, true, false>;
+template struct OutOfLineInvoke<jobject, false, false>;
+template struct OutOfLineInvoke<jobject, false, true>;
+template struct OutOfLineInvoke<jobject, true, false>;
+
+template struct OutOfLineField<jboolean, false>;
+template struct OutOfLineField<jboolean, true>;
+template struct OutOfLineField<jbyte, false>;
+template struct OutOfLineField<jbyte, true>;
+template struct OutOfLineField<jchar, false>;
+template struct OutOfLineField<jchar, true>;
+template struct OutOfLineField<jshort, false>;
+template struct OutOfLineField<jshort, true>;
+template struct OutOfLineField<jint, false>;
+template struct OutOfLineField<jint, true>;
+template struct OutOfLineField<jlong, false>;
+template struct OutOfLineField<jlong, true>;
+template struct OutOfLineField<jfloat, false>;
+template struct OutOfLineField<jfloat, true>;
+template struct OutOfLineField<jdouble, false>;
+template struct OutOfLineField<jdouble, true>;
+
+}  // namespace jni
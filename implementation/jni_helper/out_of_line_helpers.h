@@ -0,0 +1,94 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_JNI_HELPER_OUT_OF_LINE_HELPERS_H_
+#define JNI_BIND_IMPLEMENTATION_JNI_HELPER_OUT_OF_LINE_HELPERS_H_
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "field_value.h"
+#include "static_field_value.h"
+#include "jni_dep.h"
+
+namespace jni {
+
+// With JNI_BIND_OUT_OF_LINE_HELPERS (set by depending on
+// //:jni_bind_out_of_line), method calls and primitive field accesses are
+// routed through the entry points below.  There is one per call type (rather
+// than per method and argument list), and they are only declared here: their
+// bodies are compiled once, in out_of_line_helpers.cc, instead of in every
+// translation unit which uses a binding.
+//
+// The bodies are built with the library's flags, so e.g. checks enabled only
+// for a consumer don't apply inside them.
+
+// |CallT| is the `Call<T>Method` return type (objects and arrays of all ranks
+// are `jobject`). Arguments are passed as C varargs, as to `Call<T>Method`.
+template <typename CallT, bool kStatic, bool kNonvirtual>
+struct OutOfLineInvoke {
+  static CallT Invoke(jobject object, jclass clazz, jmethodID method_id, ...);
+};
+
+template <typename ReturnType, std::size_t kRank>
+using OutOfLineCall_t =
+    std::conditional_t<kRank == 0 && (std::is_void_v<ReturnType> ||
+                                      std::is_arithmetic_v<ReturnType>),
+                       ReturnType, jobject>;
+
+// Primitive fields (|kStatic| fields are accessed through their class).
+template <typename T, bool kStatic>
+struct OutOfLineField {
+  using SelfT = std::conditional_t<kStatic, jclass, jobject>;
+
+  static T GetValue(SelfT self, jfieldID field_id);
+  static void SetValue(SelfT self, jfieldID field_id, T value);
+};
+
+// Routes to `OutOfLineField` for primitive fields if enabled, otherwise calls
+// `FieldHelper` directly (the default).
+template <typename Raw, std::size_t kRank, bool kStatic>
+struct FieldDispatch {
+#if defined(JNI_BIND_OUT_OF_LINE_HELPERS) && !defined(DRY_RUN)
+  static constexpr bool kOutOfLine = kRank == 0 && std::is_arithmetic_v<Raw>;
+#else
+  static constexpr bool kOutOfLine = false;
+#endif
+
+  template <typename Self>
+  static auto GetValue(Self self, jfieldID field_id) {
+    if constexpr (kOutOfLine) {
+      return OutOfLineField<Raw, kStatic>::GetValue(self, field_id);
+    } else {
+      return FieldHelper<Raw, kRank, kStatic>::GetValue(self, field_id);
+    }
+  }
+
+  template <typename Self, typename T>
+  static void SetValue(Self self, jfieldID field_id, T&& value) {
+    if constexpr (kOutOfLine) {
+      OutOfLineField<Raw, kStatic>::SetValue(self, field_id, value);
+    } else {
+      FieldHelper<Raw, kRank, kStatic>::SetValue(self, field_id,
+                                                 std::forward<T>(value));
+    }
+  }
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_JNI_HELPER_OUT_OF_LINE_HELPERS_H_
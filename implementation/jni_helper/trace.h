@@ -20,11 +20,30 @@
 #include <utility>
 
 #include "arg_string.h"
+#include "implementation/jni_helper/jni_check.h"
 #include "metaprogramming/color.h"
 #include "metaprogramming/lambda_string.h"
 
+#ifdef JNI_BIND_ENABLE_RECORDING
+#include "implementation/jni_helper/call_recorder.h"
+#endif
+
 namespace jni {
 
+#ifdef JNI_BIND_ENABLE_RECORDING
+using TraceRecorder = CallRecorder;
+#else
+// Recording is compiled out, so the recorder (and its <mutex> and containers)
+// isn't pulled into every translation unit.
+struct TraceRecorder {
+  template <typename Tag, typename... Args>
+  static inline void RecordCall(Tag, const Args&...) {}
+
+  template <typename T>
+  static inline void RecordResult(const T&) {}
+};
+#endif
+
 // Called once, before any arguments are printed.
 template <char... chars>
 inline void PreTrace(metaprogramming::StringAsType<chars...> tag) {
@@ -77,6 +96,9 @@ inline void PostTrace(metaprogramming::StringAsType<chars...> tag) {
 template <char... chars, typename... Args>
 inline void Trace(metaprogramming::StringAsType<chars...> tag,
                   const Args&... args) {
+  JniCheck::BeforeCall(tag);
+  TraceRecorder::RecordCall(tag, args...);
+
 // WARNING: This define is temporary and will be replaced. This unblocks
 // 1.0 release but will eventually be configurable at compile time.
 #ifdef ENABLE_DEBUG_OUTPUT
@@ -87,6 +109,15 @@ inline void Trace(metaprogramming::StringAsType<chars...> tag,
 #endif
 }
 
+// Called with the result of calls whose results are needed to replay a
+// recording (see `CallRecorder`).
+template <typename T>
+inline T TraceResult(T result) {
+  TraceRecorder::RecordResult(result);
+
+  return result;
+}
+
 }  // namespace jni
 
 #endif  // JNI_BIND_IMPLEMENTATION_JNI_HELPER_TRACE_H_
@@ -26,6 +26,7 @@
 #include "implementation/class_loader.h"
 #include "implementation/class_ref.h"
 #include "implementation/default_class_loader.h"
+#include "implementation/embedded_class.h"
 #include "implementation/field_ref.h"
 #include "implementation/forward_declarations.h"
 #include "implementation/global_class_loader.h"
@@ -94,8 +95,11 @@ class JvmRef : public JvmRefBase {
     }
   }
 
-  explicit JvmRef(JNIEnv* env) : JvmRefBase(BuildJavaVMFromEnv(env)) {}
-  explicit JvmRef(JavaVM* vm) : JvmRefBase(vm) {}
+  explicit JvmRef(JNIEnv* env) : JvmRefBase(BuildJavaVMFromEnv(env)) {
+    EmbeddedClass::DefineAll();
+  }
+
+  explicit JvmRef(JavaVM* vm) : JvmRefBase(vm) { EmbeddedClass::DefineAll(); }
 
   ~JvmRef() {
     TeardownClassloadersHelper(
@@ -110,30 +114,19 @@ class JvmRef : public JvmRefBase {
     //     ReleaseAllClassRefsForDefaultClassLoader will only ever be torn down
     //     by JvmRef::~JvmRef, and JvmRef cannot be moved, therefore it is
     //     guaranteed to be in a single threaded context.
-    auto& default_loaded_class_list = DefaultRefs<jclass>();
-    for (metaprogramming::DoubleLockedValue<jclass>* maybe_loaded_class_id :
-         default_loaded_class_list) {
-      maybe_loaded_class_id->Reset([](jclass clazz) {
-        LifecycleHelper<jobject, LifecycleType::GLOBAL>::Delete(clazz);
-      });
-    }
-    default_loaded_class_list.clear();
-
-    // Methods do not need to be released, just forgotten.
-    auto& default_loaded_method_ref_list = DefaultRefs<jmethodID>();
-    for (metaprogramming::DoubleLockedValue<jmethodID>* cached_method_id :
-         default_loaded_method_ref_list) {
-      cached_method_id->Reset();
-    }
-    default_loaded_method_ref_list.clear();
-
-    // Fields do not need to be released, just forgotten.
-    auto& default_loaded_field_ref_list = GetDefaultLoadedFieldList();
-    for (metaprogramming::DoubleLockedValue<jfieldID>* cached_field_id :
-         default_loaded_field_ref_list) {
-      cached_field_id->Reset();
-    }
-    default_loaded_field_ref_list.clear();
+    DefaultRefs<jclass>().ForEachAndClear(
+        [](metaprogramming::DoubleLockedValue<jclass>* maybe_loaded_class_id) {
+          maybe_loaded_class_id->Reset([](jclass clazz) {
+            LifecycleHelper<jobject, LifecycleType::GLOBAL>::Delete(clazz);
+          });
+        });
+
+    // Methods and fields do not need to be released, just forgotten.
+    JvmEpoch::Advance();
+
+    // Cached `Final` constants hold boxes and globals which must be released.
+    GetCachedConstantResetList().ForEachAndClear(
+        [](void (*reset_cached_constant)()) { reset_cached_constant(); });
   }
 
   // Deleted in order to make various threading guarantees (see class_ref.h).
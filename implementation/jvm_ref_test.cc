@@ -24,10 +24,13 @@
 using ::jni::Class;
 using ::jni::Fake;
 using ::jni::JvmRef;
+using ::jni::Field;
 using ::jni::LocalObject;
+using ::jni::Method;
 using ::jni::test::AsGlobal;
 using ::jni::test::JniTest;
 using ::jni::test::JniTestWithNoDefaultJvmRef;
+using ::testing::_;
 using ::testing::AnyNumber;
 using ::testing::Return;
 
@@ -93,6 +96,40 @@ TEST_F(JniTestWithNoDefaultJvmRef, JvmRefsDontReuuseStaleFindClassValues) {
   }
 }
 
+TEST_F(JniTestWithNoDefaultJvmRef, JvmRefsDontReuseStaleMethodOrFieldIds) {
+  EXPECT_CALL(*env_, FindClass)
+      .WillOnce(Return(Fake<jclass>(1)))
+      .WillOnce(Return(Fake<jclass>(2)));
+  EXPECT_CALL(*env_, DeleteGlobalRef).Times(AnyNumber());
+
+  // IDs are looked up again against the reloaded class.
+  EXPECT_CALL(*env_, GetMethodID(AsGlobal(Fake<jclass>(1)), _, _))
+      .WillOnce(Return(Fake<jmethodID>(1)));
+  EXPECT_CALL(*env_, GetMethodID(AsGlobal(Fake<jclass>(2)), _, _))
+      .WillOnce(Return(Fake<jmethodID>(2)));
+  EXPECT_CALL(*env_, GetFieldID(AsGlobal(Fake<jclass>(1)), _, _))
+      .WillOnce(Return(Fake<jfieldID>(1)));
+  EXPECT_CALL(*env_, GetFieldID(AsGlobal(Fake<jclass>(2)), _, _))
+      .WillOnce(Return(Fake<jfieldID>(2)));
+
+  EXPECT_CALL(*env_, CallVoidMethodV(_, Fake<jmethodID>(1), _)).Times(2);
+  EXPECT_CALL(*env_, CallVoidMethodV(_, Fake<jmethodID>(2), _)).Times(2);
+  EXPECT_CALL(*env_, GetIntField(_, Fake<jfieldID>(1))).Times(2);
+  EXPECT_CALL(*env_, GetIntField(_, Fake<jfieldID>(2))).Times(2);
+
+  static constexpr Class kClass{"com/google/AClassWithCachedIds",
+                                Method{"Foo", jni::Return<void>{}},
+                                Field{"intVal", int{}}};
+  for (int i = 0; i < 2; ++i) {
+    JvmRef<jni::kDefaultJvm> jvm_ref(jvm_.get());
+    LocalObject<kClass> local_object{Fake<jobject>()};
+    local_object("Foo");
+    local_object("Foo");
+    local_object["intVal"].Get();
+    local_object["intVal"].Get();
+  }
+}
+
 TEST_F(JniTest, DefaultLoaderReleasesMultipleClasses) {
   EXPECT_CALL(*env_, FindClass)
       .WillOnce(Return(Fake<jclass>(1)))
@@ -0,0 +1,387 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_KERNELS_H_
+#define JNI_BIND_IMPLEMENTATION_KERNELS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <thread>  // NOLINT
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "implementation/array_type_conversion.h"
+#include "implementation/array_view.h"
+#include "implementation/jfr_events.h"
+#include "implementation/jni_helper/jni_array_helper.h"
+#include "implementation/local_array.h"
+#include "jni_dep.h"
+
+// Common computations over primitive arrays, run directly on pinned memory so
+// a native call needn't copy an array out only to reduce it, e.g.
+//
+//   jlong total = jni::kernels::Sum(LocalArray<jint>{values});
+//   jni::kernels::Sort(LocalArray<jfloat>{scores});
+//
+// Each kernel takes either a raw (pointer, size), a pinned `ArrayView`, or a
+// `LocalArray`.  `LocalArray`s are pinned with `GetPrimitiveArrayCritical`
+// (which avoids the copy `Get<Type>ArrayElements` may make) only for the
+// duration of the kernel.  The loops use independent accumulators so they can
+// be vectorised by the compiler for whatever target the library is built for.
+namespace jni::kernels {
+
+// Integral sums are widened to `jlong`, floating point sums to `jdouble`.
+template <typename T>
+using Accumulator_t =
+    std::conditional_t<std::is_floating_point_v<T>, jdouble, jlong>;
+
+// Pins |array| with `GetPrimitiveArrayCritical` for the lifetime of the
+// object.  No JNI calls may be made while it is held, so to pin several arrays
+// at once, read every length up front and pass |size| explicitly.
+//
+// If the pin fails (with `OutOfMemoryError` pending) the array is empty, so
+// kernels return early without touching memory.
+template <typename T>
+class CriticalArray : JfrPinTimer<> {
+ public:
+  explicit CriticalArray(jarray array, bool copy_on_completion = false)
+      : CriticalArray(array, JniArrayHelperBase::GetLength(array),
+                      copy_on_completion) {}
+
+  CriticalArray(jarray array, std::size_t size,
+                bool copy_on_completion = false)
+      : array_(array),
+        ptr_(static_cast<T*>(
+            JniArrayHelperBase::GetPrimitiveArrayCritical(array))),
+        size_(ptr_ == nullptr ? 0 : size),
+        copy_on_completion_(copy_on_completion) {
+    StartPin(/*critical=*/true);
+  }
+
+  CriticalArray(const CriticalArray&) = delete;
+  CriticalArray& operator=(const CriticalArray&) = delete;
+
+  ~CriticalArray() {
+    if (ptr_ != nullptr) {
+      JniArrayHelperBase::ReleasePrimitiveArrayCritical(array_, ptr_,
+                                                        copy_on_completion_);
+    }
+    EndPin("CriticalArray");
+  }
+
+  T* ptr() const { return ptr_; }
+  std::size_t Size() const { return size_; }
+
+ private:
+  const jarray array_;
+  T* const ptr_;
+  const std::size_t size_;
+  const bool copy_on_completion_;
+};
+
+template <typename T>
+CriticalArray<T> PinCritical(const LocalArray<T>& array,
+                             bool copy_on_completion = false) {
+  return CriticalArray<T>{static_cast<RegularToArrayTypeMap_t<T>>(array),
+                          copy_on_completion};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sum.
+////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+Accumulator_t<T> Sum(const T* data, std::size_t size) {
+  Accumulator_t<T> acc[4] = {};
+
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    acc[0] += data[i];
+    acc[1] += data[i + 1];
+    acc[2] += data[i + 2];
+    acc[3] += data[i + 3];
+  }
+  for (; i < size; ++i) {
+    acc[0] += data[i];
+  }
+
+  return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+template <typename T>
+Accumulator_t<T> Sum(const ArrayView<T, 1>& view) {
+  return Sum(view.ptr(), view.Size());
+}
+
+template <typename T>
+Accumulator_t<T> Sum(const LocalArray<T>& array) {
+  CriticalArray<T> pinned{PinCritical(array)};
+  return Sum(pinned.ptr(), pinned.Size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// MinMax.
+////////////////////////////////////////////////////////////////////////////////
+// Empty if |size| is 0.  NaNs are ignored unless every element is NaN.
+template <typename T>
+std::optional<std::pair<T, T>> MinMax(const T* data, std::size_t size) {
+  if (size == 0) {
+    return std::nullopt;
+  }
+
+  // Seed from the first non-NaN element (only NaN compares unequal to itself),
+  // as every comparison against a NaN seed would be false.
+  std::size_t first = 0;
+  while (first + 1 < size && data[first] != data[first]) {
+    ++first;
+  }
+
+  T min = data[first];
+  T max = data[first];
+  for (std::size_t i = first + 1; i < size; ++i) {
+    min = data[i] < min ? data[i] : min;
+    max = max < data[i] ? data[i] : max;
+  }
+
+  return std::pair{min, max};
+}
+
+template <typename T>
+std::optional<std::pair<T, T>> MinMax(const ArrayView<T, 1>& view) {
+  return MinMax(view.ptr(), view.Size());
+}
+
+template <typename T>
+std::optional<std::pair<T, T>> MinMax(const LocalArray<T>& array) {
+  CriticalArray<T> pinned{PinCritical(array)};
+  return MinMax(pinned.ptr(), pinned.Size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Dot.
+////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+Accumulator_t<T> Dot(const T* lhs, const T* rhs, std::size_t size) {
+  Accumulator_t<T> acc[4] = {};
+
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    acc[0] += static_cast<Accumulator_t<T>>(lhs[i]) * rhs[i];
+    acc[1] += static_cast<Accumulator_t<T>>(lhs[i + 1]) * rhs[i + 1];
+    acc[2] += static_cast<Accumulator_t<T>>(lhs[i + 2]) * rhs[i + 2];
+    acc[3] += static_cast<Accumulator_t<T>>(lhs[i + 3]) * rhs[i + 3];
+  }
+  for (; i < size; ++i) {
+    acc[0] += static_cast<Accumulator_t<T>>(lhs[i]) * rhs[i];
+  }
+
+  return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+// Arrays of different lengths are treated as the length of the shorter.
+template <typename T>
+Accumulator_t<T> Dot(const ArrayView<T, 1>& lhs, const ArrayView<T, 1>& rhs) {
+  return Dot(lhs.ptr(), rhs.ptr(), std::min(lhs.Size(), rhs.Size()));
+}
+
+template <typename T>
+Accumulator_t<T> Dot(const LocalArray<T>& lhs, const LocalArray<T>& rhs) {
+  const jarray lhs_array = static_cast<RegularToArrayTypeMap_t<T>>(lhs);
+  const jarray rhs_array = static_cast<RegularToArrayTypeMap_t<T>>(rhs);
+
+  // Multiple critical regions may be held at once, but `GetArrayLength` may
+  // not be called inside one, so both lengths are read before either pin.
+  const std::size_t lhs_size = JniArrayHelperBase::GetLength(lhs_array);
+  const std::size_t rhs_size = JniArrayHelperBase::GetLength(rhs_array);
+
+  CriticalArray<T> lhs_pinned{lhs_array, lhs_size};
+  CriticalArray<T> rhs_pinned{rhs_array, rhs_size};
+
+  return Dot(lhs_pinned.ptr(), rhs_pinned.ptr(),
+             std::min(lhs_pinned.Size(), rhs_pinned.Size()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Histogram.
+////////////////////////////////////////////////////////////////////////////////
+// Counts elements into |num_buckets| equal width buckets over [lo, hi).
+// Elements outside the range are not counted.  |lo| and |hi| don't take part
+// in deduction, so literals of any type may be passed.
+template <typename T>
+std::vector<std::size_t> Histogram(const T* data, std::size_t size,
+                                   std::common_type_t<T> lo,
+                                   std::common_type_t<T> hi,
+                                   std::size_t num_buckets) {
+  std::vector<std::size_t> ret(num_buckets, 0);
+  if (num_buckets == 0 || !(lo < hi)) {
+    return ret;
+  }
+
+  const jdouble scale = num_buckets / (static_cast<jdouble>(hi) - lo);
+  for (std::size_t i = 0; i < size; ++i) {
+    if (lo <= data[i] && data[i] < hi) {
+      const auto bucket = static_cast<std::size_t>(
+          (static_cast<jdouble>(data[i]) - lo) * scale);
+
+      // Rounding may place values just under |hi| one past the end.
+      ++ret[std::min(bucket, num_buckets - 1)];
+    }
+  }
+
+  return ret;
+}
+
+template <typename T>
+std::vector<std::size_t> Histogram(const ArrayView<T, 1>& view,
+                                   std::common_type_t<T> lo,
+                                   std::common_type_t<T> hi,
+                                   std::size_t num_buckets) {
+  return Histogram(view.ptr(), view.Size(), lo, hi, num_buckets);
+}
+
+template <typename T>
+std::vector<std::size_t> Histogram(const LocalArray<T>& array,
+                                   std::common_type_t<T> lo,
+                                   std::common_type_t<T> hi,
+                                   std::size_t num_buckets) {
+  CriticalArray<T> pinned{PinCritical(array)};
+  return Histogram(pinned.ptr(), pinned.Size(), lo, hi, num_buckets);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort.
+////////////////////////////////////////////////////////////////////////////////
+// Floating point values are sorted in the total order of Java's
+// `Arrays.sort`: -0.0 before 0.0, and NaNs last (`<` alone isn't a strict weak
+// ordering once NaNs are present).
+template <typename T>
+bool TotalOrderLess(T lhs, T rhs) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (rhs != rhs) {
+      return lhs == lhs;
+    }
+    if (lhs == rhs) {
+      return std::signbit(lhs) && !std::signbit(rhs);
+    }
+  }
+
+  return lhs < rhs;
+}
+
+template <typename T>
+void Sort(T* data, std::size_t size) {
+  if constexpr (std::is_floating_point_v<T>) {
+    std::sort(data, data + size, TotalOrderLess<T>);
+  } else {
+    std::sort(data, data + size);
+  }
+}
+
+// |view| must copy on completion for the result to be visible in Java.
+template <typename T>
+void Sort(const ArrayView<T, 1>& view) {
+  Sort(view.ptr(), view.Size());
+}
+
+// The array is pinned for the whole sort, which stalls the garbage collector
+// for large arrays.  Prefer `LocalArray::Pin` and the `ArrayView` overload if
+// that matters.
+template <typename T>
+void Sort(const LocalArray<T>& array) {
+  CriticalArray<T> pinned{PinCritical(array, true)};
+  Sort(pinned.ptr(), pinned.Size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Parallel variants.
+//
+// Work is split into |num_threads| contiguous ranges, the first of which runs
+// on the calling thread.  Workers only touch native memory and make no JNI
+// calls, so they need not be attached.  Because the calling thread blocks on
+// the workers, these take an `ArrayView` (`LocalArray::Pin`) rather than a
+// critical pin.
+////////////////////////////////////////////////////////////////////////////////
+template <typename R, typename Fn>
+std::vector<R> ParallelMap(std::size_t size, std::size_t num_threads, Fn fn) {
+  num_threads = std::max<std::size_t>(1, std::min(num_threads, size));
+
+  std::vector<R> results(num_threads);
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads - 1);
+
+  const std::size_t chunk = (size + num_threads - 1) / num_threads;
+  for (std::size_t i = 1; i < num_threads; ++i) {
+    workers.emplace_back([&, i]() {
+      const std::size_t begin = std::min(size, i * chunk);
+      results[i] = fn(begin, std::min(size, begin + chunk));
+    });
+  }
+  results[0] = fn(0, std::min(size, chunk));
+
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  return results;
+}
+
+template <typename T>
+Accumulator_t<T> ParallelSum(const T* data, std::size_t size,
+                             std::size_t num_threads) {
+  Accumulator_t<T> ret{};
+  for (Accumulator_t<T> partial : ParallelMap<Accumulator_t<T>>(
+           size, num_threads, [data](std::size_t begin, std::size_t end) {
+             return Sum(data + begin, end - begin);
+           })) {
+    ret += partial;
+  }
+
+  return ret;
+}
+
+template <typename T>
+Accumulator_t<T> ParallelSum(const ArrayView<T, 1>& view,
+                             std::size_t num_threads) {
+  return ParallelSum(view.ptr(), view.Size(), num_threads);
+}
+
+template <typename T>
+Accumulator_t<T> ParallelDot(const T* lhs, const T* rhs, std::size_t size,
+                             std::size_t num_threads) {
+  Accumulator_t<T> ret{};
+  for (Accumulator_t<T> partial : ParallelMap<Accumulator_t<T>>(
+           size, num_threads, [lhs, rhs](std::size_t begin, std::size_t end) {
+             return Dot(lhs + begin, rhs + begin, end - begin);
+           })) {
+    ret += partial;
+  }
+
+  return ret;
+}
+
+template <typename T>
+Accumulator_t<T> ParallelDot(const ArrayView<T, 1>& lhs,
+                             const ArrayView<T, 1>& rhs,
+                             std::size_t num_threads) {
+  return ParallelDot(lhs.ptr(), rhs.ptr(), std::min(lhs.Size(), rhs.Size()),
+                     num_threads);
+}
+
+}  // namespace jni::kernels
+
+#endif  // JNI_BIND_IMPLEMENTATION_KERNELS_H_
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::AdoptLocal;
+using ::jni::Fake;
+using ::jni::LocalArray;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::Optional;
+using ::testing::Return;
+
+namespace kernels = ::jni::kernels;
+
+TEST(Kernels, SumsWithWideAccumulator) {
+  const std::vector<jint> values(1001, 1 << 30);
+
+  EXPECT_EQ(kernels::Sum(values.data(), values.size()), jlong{1001} << 30);
+  EXPECT_EQ(kernels::Sum(values.data(), 0), 0);
+}
+
+TEST(Kernels, FindsMinMax) {
+  const std::vector<jfloat> values{3.f, -1.f, 7.f, 2.f};
+
+  EXPECT_THAT(kernels::MinMax(values.data(), values.size()),
+              Optional(Eq(std::pair{-1.f, 7.f})));
+  EXPECT_EQ(kernels::MinMax(values.data(), 0), std::nullopt);
+}
+
+TEST(Kernels, MinMaxIgnoresLeadingNaN) {
+  const jfloat nan = std::numeric_limits<jfloat>::quiet_NaN();
+  const std::vector<jfloat> values{nan, 3.f, nan, -1.f, 7.f};
+
+  EXPECT_THAT(kernels::MinMax(values.data(), values.size()),
+              Optional(Eq(std::pair{-1.f, 7.f})));
+
+  const std::vector<jfloat> all_nan{nan, nan};
+  auto min_max = kernels::MinMax(all_nan.data(), all_nan.size());
+  ASSERT_TRUE(min_max.has_value());
+  EXPECT_TRUE(std::isnan(min_max->first));
+  EXPECT_TRUE(std::isnan(min_max->second));
+}
+
+TEST(Kernels, ComputesDotProduct) {
+  const std::vector<jdouble> lhs{1, 2, 3, 4, 5};
+  const std::vector<jdouble> rhs{2, 2, 2, 2, 2};
+
+  EXPECT_EQ(kernels::Dot(lhs.data(), rhs.data(), lhs.size()), 30.0);
+}
+
+TEST(Kernels, BucketsHistogram) {
+  const std::vector<jint> values{-1, 0, 1, 4, 5, 9, 10};
+
+  EXPECT_THAT(kernels::Histogram(values.data(), values.size(), 0, 10, 2),
+              ElementsAre(3, 2));
+}
+
+TEST(Kernels, Sorts) {
+  std::vector<jlong> values{3, 1, 2};
+  kernels::Sort(values.data(), values.size());
+
+  EXPECT_THAT(values, ElementsAre(1, 2, 3));
+}
+
+TEST(Kernels, SortsFloatsInJavaTotalOrder) {
+  constexpr jdouble kNaN = std::numeric_limits<jdouble>::quiet_NaN();
+  constexpr jdouble kInf = std::numeric_limits<jdouble>::infinity();
+  std::vector<jdouble> values{kNaN, 1.0, 0.0, kInf, -0.0, kNaN, -kInf, -1.0};
+  kernels::Sort(values.data(), values.size());
+
+  EXPECT_THAT(values, ElementsAre(-kInf, -1.0, 0.0, 0.0, 1.0, kInf, _, _));
+  EXPECT_TRUE(std::signbit(values[2]));
+  EXPECT_FALSE(std::signbit(values[3]));
+  EXPECT_TRUE(std::isnan(values[6]));
+  EXPECT_TRUE(std::isnan(values[7]));
+}
+
+TEST(Kernels, ParallelVariantsMatchSerial) {
+  std::vector<jint> values(10007);
+  std::iota(values.begin(), values.end(), -5000);
+
+  for (std::size_t num_threads : {1, 3, 8}) {
+    EXPECT_EQ(kernels::ParallelSum(values.data(), values.size(), num_threads),
+              kernels::Sum(values.data(), values.size()));
+    EXPECT_EQ(kernels::ParallelDot(values.data(), values.data(), values.size(),
+                                   num_threads),
+              kernels::Dot(values.data(), values.data(), values.size()));
+  }
+}
+
+TEST_F(JniTest, Kernels_PinsLocalArraysCritically) {
+  static jint values[] = {1, 2, 3, 4};
+
+  EXPECT_CALL(*env_, GetArrayLength(Fake<jintArray>())).WillOnce(Return(4));
+  EXPECT_CALL(*env_, GetPrimitiveArrayCritical(Fake<jintArray>(), _))
+      .WillOnce(Return(values));
+  EXPECT_CALL(*env_,
+              ReleasePrimitiveArrayCritical(Fake<jintArray>(), values,
+                                            JNI_ABORT));
+  EXPECT_CALL(*env_, GetIntArrayElements).Times(0);
+
+  LocalArray<jint> arr{AdoptLocal{}, Fake<jintArray>()};
+  EXPECT_EQ(kernels::Sum(arr), 10);
+}
+
+TEST_F(JniTest, Kernels_SortCopiesBack) {
+  static jint values[] = {3, 1, 2};
+
+  EXPECT_CALL(*env_, GetArrayLength(Fake<jintArray>())).WillOnce(Return(3));
+  EXPECT_CALL(*env_, GetPrimitiveArrayCritical(Fake<jintArray>(), _))
+      .WillOnce(Return(values));
+  EXPECT_CALL(*env_,
+              ReleasePrimitiveArrayCritical(Fake<jintArray>(), values, 0));
+
+  LocalArray<jint> arr{AdoptLocal{}, Fake<jintArray>()};
+  kernels::Sort(arr);
+
+  EXPECT_THAT(values, ElementsAre(1, 2, 3));
+}
+
+TEST_F(JniTest, Kernels_FailedCriticalPinIsEmpty) {
+  EXPECT_CALL(*env_, GetArrayLength(Fake<jintArray>())).WillOnce(Return(4));
+  EXPECT_CALL(*env_, GetPrimitiveArrayCritical(Fake<jintArray>(), _))
+      .WillOnce(Return(nullptr));
+  EXPECT_CALL(*env_, ReleasePrimitiveArrayCritical).Times(0);
+
+  LocalArray<jint> arr{AdoptLocal{}, Fake<jintArray>()};
+  EXPECT_EQ(kernels::Sum(arr), 0);
+}
+
+}  // namespace
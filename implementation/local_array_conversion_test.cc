@@ -0,0 +1,148 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::AdoptLocal;
+using ::jni::Fake;
+using ::jni::LocalArray;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::InSequence;
+using ::testing::Return;
+
+TEST_F(JniTest, CopyConverted_WidensIntsToFloats) {
+  EXPECT_CALL(*env_, GetArrayLength(Fake<jintArray>())).WillOnce(Return(3));
+  EXPECT_CALL(*env_, GetIntArrayRegion(Fake<jintArray>(), 0, 3, _))
+      .WillOnce([](jintArray, jsize, jsize, jint* buf) {
+        buf[0] = 1;
+        buf[1] = -2;
+        buf[2] = 3;
+      });
+
+  LocalArray<jint> arr{AdoptLocal{}, Fake<jintArray>()};
+
+  EXPECT_THAT(arr.CopyConverted<float>(), ElementsAre(1.f, -2.f, 3.f));
+}
+
+TEST_F(JniTest, CopyConverted_CopiesInChunks) {
+  std::vector<std::uint8_t> out(600);
+
+  InSequence seq;
+  EXPECT_CALL(*env_, GetByteArrayRegion(Fake<jbyteArray>(), 10, 256, _));
+  EXPECT_CALL(*env_, GetByteArrayRegion(Fake<jbyteArray>(), 266, 256, _));
+  EXPECT_CALL(*env_, GetByteArrayRegion(Fake<jbyteArray>(), 522, 88, _));
+
+  LocalArray<jbyte> arr{AdoptLocal{}, Fake<jbyteArray>()};
+  arr.CopyConverted(out.data(), out.size(), 10);
+}
+
+TEST_F(JniTest, SetConverted_NarrowsDoublesToFloats) {
+  const std::vector<double> in{1.5, 2.5};
+
+  EXPECT_CALL(*env_, SetFloatArrayRegion(Fake<jfloatArray>(), 1, 2, _))
+      .WillOnce([](jfloatArray, jsize, jsize, const jfloat* buf) {
+        EXPECT_EQ(buf[0], 1.5f);
+        EXPECT_EQ(buf[1], 2.5f);
+      });
+
+  LocalArray<jfloat> arr{AdoptLocal{}, Fake<jfloatArray>()};
+  arr.SetConverted(in.data(), in.size(), 1);
+}
+
+TEST_F(JniTest, CopyConverted_SaturatesFloatsLikeJava) {
+  EXPECT_CALL(*env_, GetArrayLength(Fake<jfloatArray>())).WillOnce(Return(4));
+  EXPECT_CALL(*env_, GetFloatArrayRegion(Fake<jfloatArray>(), 0, 4, _))
+      .WillOnce([](jfloatArray, jsize, jsize, jfloat* buf) {
+        buf[0] = std::numeric_limits<jfloat>::quiet_NaN();
+        buf[1] = 1e20f;
+        buf[2] = -1e20f;
+        buf[3] = -2.5f;
+      });
+
+  LocalArray<jfloat> arr{AdoptLocal{}, Fake<jfloatArray>()};
+
+  EXPECT_THAT(arr.CopyConverted<jint>(),
+              ElementsAre(0, std::numeric_limits<jint>::max(),
+                          std::numeric_limits<jint>::min(), -2));
+}
+
+TEST_F(JniTest, CopyConverted_StopsOnceARegionThrows) {
+  std::vector<jint> out(600);
+
+  EXPECT_CALL(*env_, GetIntArrayRegion(Fake<jintArray>(), 0, 256, _));
+  EXPECT_CALL(*env_, ExceptionCheck).WillOnce(Return(JNI_TRUE));
+
+  LocalArray<jint> arr{AdoptLocal{}, Fake<jintArray>()};
+  arr.CopyConverted(out.data(), out.size());
+}
+
+TEST_F(JniTest, SetConverted_StopsOnceARegionThrows) {
+  const std::vector<double> in(600, 1e300);
+
+  EXPECT_CALL(*env_, SetLongArrayRegion(Fake<jlongArray>(), 0, 256, _))
+      .WillOnce([](jlongArray, jsize, jsize, const jlong* buf) {
+        EXPECT_EQ(buf[0], std::numeric_limits<jlong>::max());
+      });
+  EXPECT_CALL(*env_, ExceptionCheck).WillOnce(Return(JNI_TRUE));
+
+  LocalArray<jlong> arr{AdoptLocal{}, Fake<jlongArray>()};
+  arr.SetConverted(in.data(), in.size());
+}
+
+TEST_F(JniTest, CopyPacked_PacksBooleansIntoBits) {
+  EXPECT_CALL(*env_, GetBooleanArrayRegion(Fake<jbooleanArray>(), 0, 10, _))
+      .WillOnce([](jbooleanArray, jsize, jsize len, jboolean* buf) {
+        for (jsize i = 0; i < len; ++i) {
+          buf[i] = i % 3 == 0 ? JNI_TRUE : JNI_FALSE;
+        }
+      });
+
+  LocalArray<jboolean> arr{AdoptLocal{}, Fake<jbooleanArray>()};
+  std::uint8_t bits[2];
+  arr.CopyPacked(bits, 10);
+
+  // Elements 0, 3, 6 and 9.
+  EXPECT_EQ(bits[0], 0b01001001);
+  EXPECT_EQ(bits[1], 0b00000010);
+}
+
+TEST_F(JniTest, SetPacked_UnpacksBitsIntoBooleans) {
+  const std::uint8_t bits[] = {0b00000101};
+
+  EXPECT_CALL(*env_, SetBooleanArrayRegion(Fake<jbooleanArray>(), 0, 4, _))
+      .WillOnce([](jbooleanArray, jsize, jsize, const jboolean* buf) {
+        EXPECT_THAT(std::vector<jboolean>(buf, buf + 4),
+                    ElementsAre(JNI_TRUE, JNI_FALSE, JNI_TRUE, JNI_FALSE));
+      });
+
+  LocalArray<jboolean> arr{AdoptLocal{}, Fake<jbooleanArray>()};
+  arr.SetPacked(bits, 4);
+}
+
+}  // namespace
@@ -27,6 +27,14 @@ namespace jni {
 struct OverloadBase {};
 struct MethodBase {};
 
+// Marks a method as non-virtual (e.g. it is `final` or `private`), e.g.
+//
+//   Method{"Foo", Nonvirtual{}, Return<void>{}, Params{jint{}}}
+//
+// These are invoked with `CallNonvirtual<T>Method` on the declaring class which
+// skips virtual dispatch.
+struct Nonvirtual {};
+
 // Represents a single overload of a given method.
 template <typename ReturnT_, typename Params_>
 struct Overload : OverloadBase {
@@ -49,14 +57,27 @@ struct Method<std::tuple<Returns...>, std::tuple<Params_...>>
  public:
   const char* name_;
   const std::tuple<Overload<Returns, Params_>...> invocations_;
+  const bool nonvirtual_ = false;
 
   template <typename ReturnT_, typename ParamsT_,
             std::enable_if_t<std::is_base_of_v<ParamsBase, ParamsT_>, int> = 0>
   constexpr Method(const char* name, ReturnT_ return_type, ParamsT_ params)
       : name_(name), invocations_(Overload{return_type, params}) {}
 
+  template <typename ReturnT_, typename ParamsT_,
+            std::enable_if_t<std::is_base_of_v<ParamsBase, ParamsT_>, int> = 0>
+  constexpr Method(const char* name, Nonvirtual, ReturnT_ return_type,
+                   ParamsT_ params)
+      : name_(name),
+        invocations_(Overload{return_type, params}),
+        nonvirtual_(true) {}
+
   constexpr Method(const char* name, Overload<Returns, Params_>... invocations)
       : name_(name), invocations_(invocations...) {}
+
+  constexpr Method(const char* name, Nonvirtual,
+                   Overload<Returns, Params_>... invocations)
+      : name_(name), invocations_(invocations...), nonvirtual_(true) {}
 };
 
 // CTAD for Non-overloaded form.
@@ -67,11 +88,22 @@ template <
 Method(const char*, ReturnT, ParamsT)
     -> Method<std::tuple<ReturnT>, std::tuple<ParamsT>>;
 
+template <
+    typename ReturnT, typename ParamsT,
+    typename = std::enable_if_t<!std::is_base_of_v<OverloadBase, ReturnT> &&
+                                !std::is_base_of_v<OverloadBase, ParamsT>>>
+Method(const char*, Nonvirtual, ReturnT, ParamsT)
+    -> Method<std::tuple<ReturnT>, std::tuple<ParamsT>>;
+
 // CTAD for Overloaded form.
 template <typename... Returns, typename... Params>
 Method(const char*, Overload<Returns, Params>...)
     -> Method<std::tuple<Returns...>, std::tuple<Params...>>;
 
+template <typename... Returns, typename... Params>
+Method(const char*, Nonvirtual, Overload<Returns, Params>...)
+    -> Method<std::tuple<Returns...>, std::tuple<Params...>>;
+
 template <typename ReturnT1, typename ParamsT1, typename ReturnT2,
           typename ParamsT2>
 constexpr bool operator==(const Method<ReturnT1, ParamsT1>& lhs,
@@ -42,6 +42,12 @@
 #include "metaprogramming/unfurl.h"
 #include "metaprogramming/vals.h"
 
+#ifdef JNI_BIND_USE_CONCEPTS
+#ifndef __cpp_concepts
+#error "JNI_BIND_USE_CONCEPTS requires C++20."
+#endif  // __cpp_concepts
+#endif  // JNI_BIND_USE_CONCEPTS
+
 namespace jni {
 
 // Viablility helper for an exact parameter.
@@ -76,6 +82,46 @@ struct ArgumentValidate {
   static constexpr bool kValid = ViableHelper<Ts...>();
 };
 
+#ifdef JNI_BIND_USE_CONCEPTS
+// Checks params [I, sizeof...(Ts)) in order, stopping at the first mismatch.
+template <typename OverloadId, IdType kReturnIDType, std::size_t I,
+          typename... Ts>
+constexpr bool ViableFrom() {
+  if constexpr (I == sizeof...(Ts)) {
+    return true;
+  } else if constexpr (!Viable<I, OverloadId,
+                               metaprogramming::Val_t<kReturnIDType>,
+                               Ts...>::val) {
+    return false;
+  } else {
+    return ViableFrom<OverloadId, kReturnIDType, I + 1, Ts...>();
+  }
+}
+
+// Constraint conjunctions short circuit, so params are only checked for
+// overloads whose arity matches.
+template <typename OverloadId, IdType kReturnIDType, typename... Ts>
+concept ViableOverload = (OverloadId::kNumParams == sizeof...(Ts)) &&
+                         (ViableFrom<OverloadId, kReturnIDType, 0, Ts...>());
+
+// First viable overload in [I, kNumOverloads), or kNoIdx. Equivalent to the
+// |Min| of all viable overloads, but nothing past the match is instantiated.
+template <typename JniT, IdType kIDType, std::size_t kIdx,
+          IdType kReturnIDType, std::size_t I, std::size_t kNumOverloads,
+          typename... Ts>
+constexpr std::size_t FirstViableOverload() {
+  if constexpr (I == kNumOverloads) {
+    return kNoIdx;
+  } else if constexpr (ViableOverload<Id<JniT, kIDType, kIdx, I>,
+                                      kReturnIDType, Ts...>) {
+    return I;
+  } else {
+    return FirstViableOverload<JniT, kIDType, kIdx, kReturnIDType, I + 1,
+                               kNumOverloads, Ts...>();
+  }
+}
+#endif  // JNI_BIND_USE_CONCEPTS
+
 template <typename IdT_, IdType kReturnIDType>
 struct OverloadSelection {
   using IdT = IdT_;
@@ -104,10 +150,17 @@ struct MethodSelection {
         kReturnIDType>::template OverloadIdxIfViable<Ts...>()>;
   };
 
+#ifdef JNI_BIND_USE_CONCEPTS
+  template <typename... Ts>
+  static constexpr std::size_t kIdxForTs =
+      FirstViableOverload<JniT, kIDType, IdT::kIdx, kReturnIDType, 0,
+                          IdT::NumParams(), Ts...>();
+#else
   template <typename... Ts>
   static constexpr std::size_t kIdxForTs = metaprogramming::ReduceAsPack_t<
       metaprogramming::Min, metaprogramming::Call_t<metaprogramming::Unfurl_t<
                                 IdT::NumParams(), Helper, Ts...>>>::val;
+#endif  // JNI_BIND_USE_CONCEPTS
 
   template <typename... Ts>
   using FindOverloadSelection =
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_NATIVE_CALLBACK_H_
+#define JNI_BIND_IMPLEMENTATION_NATIVE_CALLBACK_H_
+
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "class_defs/java_lang_classes.h"
+#include "class_defs/java_util_function_classes.h"
+#include "implementation/embedded_class.h"
+#include "implementation/field_ref.h"
+#include "implementation/global_object.h"
+#include "implementation/jni_helper/field_value.h"
+#include "implementation/jni_helper/jni_env.h"
+#include "implementation/jni_helper/jni_helper.h"
+#include "implementation/jni_helper/lifecycle_object.h"
+#include "implementation/promotion_mechanics_tags.h"
+#include "implementation/ref_base.h"
+#include "implementation/ref_storage.h"
+#include "implementation/thread_guard.h"
+#include "java/com/jnibind/native_callback_class_bytes.h"
+#include "jni_dep.h"
+#include "metaprogramming/double_locked_value.h"
+#include "metaprogramming/epoch_locked_value.h"
+
+namespace jni {
+
+// Type erased native half of a `com.jnibind.NativeCallback`.
+class NativeCallbackBase {
+ public:
+  virtual ~NativeCallbackBase() = default;
+
+  // `arg` is null for `Runnable` and `Supplier`. Returns a local (or null).
+  virtual jobject Invoke(jobject arg) = 0;
+};
+
+template <typename Lambda>
+class NativeCallbackImpl : public NativeCallbackBase {
+ public:
+  explicit NativeCallbackImpl(Lambda lambda) : lambda_(std::move(lambda)) {}
+
+  jobject Invoke(jobject arg) override {
+    if constexpr (std::is_invocable_v<Lambda&, jobject>) {
+      return InvokeAndReturn(arg);
+    } else {
+      return InvokeAndReturn();
+    }
+  }
+
+ private:
+  template <typename... Args>
+  jobject InvokeAndReturn(Args... args) {
+    using ReturnT = std::invoke_result_t<Lambda&, Args...>;
+
+    if constexpr (std::is_void_v<ReturnT>) {
+      lambda_(args...);
+      return nullptr;
+    } else if constexpr (std::is_base_of_v<RefBaseBase, ReturnT>) {
+      // e.g. `LocalObject`, ownership is passed to the JVM.
+      return lambda_(args...).Release();
+    } else {
+      return lambda_(args...);
+    }
+  }
+
+  Lambda lambda_;
+};
+
+// Defines `com.jnibind.NativeCallback` from its embedded bytecode and binds
+// its native method.  This happens once for every `JvmRef` (the class, method
+// and field are released in `JvmRef::~JvmRef`).
+//
+// Note: Android does not support `DefineClass`.
+struct NativeCallbackClass {
+  static constexpr const char* kName = "com/jnibind/NativeCallback";
+
+  static jobject JNICALL Invoke(JNIEnv* env, jclass, jlong handle,
+                                jobject arg) {
+    ThreadGuard thread_guard{};
+
+    if (handle == 0) {
+      env->ThrowNew(env->FindClass("java/lang/IllegalStateException"),
+                    "NativeCallback invoked after it was destroyed.");
+      return nullptr;
+    }
+
+    return reinterpret_cast<NativeCallbackBase*>(handle)->Invoke(arg);
+  }
+
+  // Returns null (with an exception pending) if the class can't be defined
+  // or its native can't be bound, in which case the next call retries.
+  static jclass GetClass() {
+    static metaprogramming::DoubleLockedValue<jclass> return_value;
+
+    return return_value.LoadAndMaybeInit([]() -> jclass {
+      // Another library in this process may have defined the class already.
+      jclass clazz = EmbeddedClass::Define(
+          kName, nullptr, kNativeCallbackClassBytes,
+          static_cast<jsize>(sizeof(kNativeCallbackClassBytes)));
+      if (clazz == nullptr) {
+        return nullptr;
+      }
+
+      static const JNINativeMethod kNativeMethods[] = {
+          {const_cast<char*>("invoke"),
+           const_cast<char*>("(JLjava/lang/Object;)Ljava/lang/Object;"),
+           reinterpret_cast<void*>(&NativeCallbackClass::Invoke)},
+      };
+      if (JniHelper::RegisterNatives(clazz, kNativeMethods, 1) != 0) {
+        LifecycleHelper<jclass, LifecycleType::LOCAL>::Delete(clazz);
+        return nullptr;
+      }
+
+      jclass global_clazz =
+          LifecycleHelper<jclass, LifecycleType::GLOBAL>::Promote(clazz);
+      DefaultRefs<jclass>().push_back(&return_value);
+
+      return global_clazz;
+    });
+  }
+
+  static jmethodID GetConstructor() {
+    static metaprogramming::EpochLockedValue<jmethodID> return_value;
+
+    return return_value.LoadAndMaybeInit(JvmEpoch::Get(), []() {
+      return JniHelper::GetMethodID(GetClass(), "<init>", "(J)V");
+    });
+  }
+
+  static jfieldID GetHandleField() {
+    static metaprogramming::EpochLockedValue<jfieldID> return_value;
+
+    return return_value.LoadAndMaybeInit(JvmEpoch::Get(), []() {
+      return JniHelper::GetFieldID(GetClass(), "handle", "J");
+    });
+  }
+};
+
+// Implements a Java functional interface with a C++ callable, e.g.
+//
+//   jni::NativeCallback<jni::kJavaLangRunnable> runnable{[] { ... }};
+//   executor("execute", runnable.Get());
+//
+// Supported interfaces (and the callable's signature) are:
+//   kJavaLangRunnable:          void()
+//   kJavaUtilFunctionConsumer:  void(jobject)
+//   kJavaUtilFunctionFunction:  R(jobject)
+//   kJavaUtilFunctionSupplier:  R()
+// where R is a `jobject` local or a `LocalObject` (whose ownership is passed
+// to the JVM).
+//
+// Invocations dispatch directly to the callable (no allocations are made) on
+// whatever thread Java invokes the interface from.  The callable must be safe
+// to call from those threads, and no invocations may be in flight when this
+// object is destroyed (later invocations throw IllegalStateException).
+template <const auto& interface_v>
+class NativeCallback {
+ public:
+  static constexpr std::string_view kInterfaceName{interface_v.name_};
+
+  static constexpr bool kTakesArg =
+      kInterfaceName == kJavaUtilFunctionConsumer.name_ ||
+      kInterfaceName == kJavaUtilFunctionFunction.name_;
+
+  static constexpr bool kReturnsObject =
+      kInterfaceName == kJavaUtilFunctionFunction.name_ ||
+      kInterfaceName == kJavaUtilFunctionSupplier.name_;
+
+  static_assert(kTakesArg || kReturnsObject ||
+                    kInterfaceName == kJavaLangRunnable.name_,
+                "NativeCallback only supports Runnable, Consumer, Function "
+                "and Supplier.");
+
+  template <typename Lambda>
+  explicit NativeCallback(Lambda&& lambda)
+      : callable_(new NativeCallbackImpl<std::decay_t<Lambda>>(
+            std::forward<Lambda>(lambda))),
+        object_(PromoteToGlobal{}, NewCallbackObject(callable_.get())) {
+    if constexpr (kTakesArg) {
+      static_assert(std::is_invocable_v<std::decay_t<Lambda>&, jobject>,
+                    "Callable must accept a jobject.");
+    } else {
+      static_assert(std::is_invocable_v<std::decay_t<Lambda>&>,
+                    "Callable must take no arguments.");
+    }
+  }
+
+  NativeCallback(const NativeCallback&) = delete;
+  NativeCallback(NativeCallback&&) = default;
+
+  ~NativeCallback() {
+    if (callable_ && static_cast<jobject>(object_) != nullptr) {
+      FieldHelper<jlong, 0, false>::SetValue(
+          static_cast<jobject>(object_), NativeCallbackClass::GetHandleField(),
+          jlong{0});
+    }
+  }
+
+  // The Java object, e.g. to pass as an argument.  This is null (and an
+  // exception was left pending on construction) if
+  // `com.jnibind.NativeCallback` couldn't be defined.
+  GlobalObject<interface_v>& Get() { return object_; }
+
+  explicit operator jobject() const { return static_cast<jobject>(object_); }
+
+ private:
+  // Returns a local, or null if `NativeCallbackClass` is unavailable.
+  static jobject NewCallbackObject(NativeCallbackBase* callable) {
+    jclass clazz = NativeCallbackClass::GetClass();
+    if (clazz == nullptr) {
+      return nullptr;
+    }
+
+    return LifecycleHelper<jobject, LifecycleType::LOCAL>::Construct(
+        clazz, NativeCallbackClass::GetConstructor(),
+        reinterpret_cast<jlong>(callable));
+  }
+
+  // Declared first so it is destroyed last.
+  std::unique_ptr<NativeCallbackBase> callable_;
+  GlobalObject<interface_v> object_;
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_NATIVE_CALLBACK_H_
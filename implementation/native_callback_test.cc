@@ -0,0 +1,154 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "implementation/native_callback.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Fake;
+using ::jni::kJavaLangRunnable;
+using ::jni::kJavaUtilFunctionConsumer;
+using ::jni::kJavaUtilFunctionFunction;
+using ::jni::LocalObject;
+using ::jni::NativeCallback;
+using ::jni::NativeCallbackClass;
+using ::jni::NativeCallbackImpl;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::Return;
+using ::testing::StrEq;
+
+TEST_F(JniTest, NativeCallback_DefinesClassOnceAndRegistersNatives) {
+  EXPECT_CALL(*env_, DefineClass(StrEq("com/jnibind/NativeCallback"), nullptr,
+                                 _, _))
+      .WillOnce(Return(Fake<jclass>()));
+  EXPECT_CALL(*env_, FindClass(StrEq("com/jnibind/NativeCallback"))).Times(0);
+  EXPECT_CALL(*env_, RegisterNatives(_, _, 1))
+      .WillOnce(testing::Invoke(
+          [](jclass, const JNINativeMethod* methods, jint) {
+            EXPECT_STREQ(methods[0].name, "invoke");
+            EXPECT_STREQ(methods[0].signature,
+                         "(JLjava/lang/Object;)Ljava/lang/Object;");
+            return 0;
+          }));
+  EXPECT_CALL(*env_, GetMethodID(_, StrEq("<init>"), StrEq("(J)V")));
+
+  NativeCallback<kJavaLangRunnable> callback_1{[] {}};
+  NativeCallback<kJavaLangRunnable> callback_2{[] {}};
+}
+
+TEST_F(JniTest, NativeCallback_FallsBackToFindClassIfAlreadyDefined) {
+  EXPECT_CALL(*env_, DefineClass).WillOnce(Return(nullptr));
+  EXPECT_CALL(*env_, ExceptionOccurred)
+      .WillOnce(Return(static_cast<jthrowable>(Fake<jobject>(7))));
+  EXPECT_CALL(*env_, IsInstanceOf).WillOnce(Return(JNI_TRUE));
+  EXPECT_CALL(*env_, ExceptionClear);
+  EXPECT_CALL(*env_, FindClass(StrEq("java/lang/LinkageError")));
+  EXPECT_CALL(*env_, FindClass(StrEq("com/jnibind/NativeCallback")));
+  EXPECT_CALL(*env_, Throw).Times(0);
+  EXPECT_CALL(*env_, RegisterNatives);
+
+  NativeCallback<kJavaLangRunnable> callback{[] {}};
+}
+
+TEST_F(JniTest, NativeCallback_LeavesDefinitionFailurePending) {
+  const jthrowable error = static_cast<jthrowable>(Fake<jobject>(7));
+
+  EXPECT_CALL(*env_, DefineClass).WillOnce(Return(nullptr));
+  EXPECT_CALL(*env_, ExceptionOccurred).WillOnce(Return(error));
+  EXPECT_CALL(*env_, IsInstanceOf).WillOnce(Return(JNI_FALSE));
+  EXPECT_CALL(*env_, FindClass(StrEq("com/jnibind/NativeCallback"))).Times(0);
+  EXPECT_CALL(*env_, Throw(error));
+  EXPECT_CALL(*env_, RegisterNatives).Times(0);
+  EXPECT_CALL(*env_, NewGlobalRef(Fake<jclass>())).Times(0);
+  EXPECT_CALL(*env_, NewObjectV).Times(0);
+  EXPECT_CALL(*env_, SetLongField).Times(0);
+
+  NativeCallback<kJavaLangRunnable> callback{[] {}};
+  EXPECT_EQ(static_cast<jobject>(callback), nullptr);
+}
+
+TEST_F(JniTest, NativeCallback_DestructionClearsHandle) {
+  ON_CALL(*env_, DefineClass).WillByDefault(Return(Fake<jclass>()));
+  EXPECT_CALL(*env_, GetFieldID(_, StrEq("handle"), StrEq("J")));
+  EXPECT_CALL(*env_, SetLongField(_, _, 0));
+
+  NativeCallback<kJavaLangRunnable> callback{[] {}};
+}
+
+TEST_F(JniTest, NativeCallback_DispatchesToCallable) {
+  int invocations = 0;
+  auto runnable = [&]() { ++invocations; };
+  NativeCallbackImpl<decltype(runnable)> runnable_impl{runnable};
+
+  EXPECT_EQ(NativeCallbackClass::Invoke(
+                env_.get(), nullptr, reinterpret_cast<jlong>(&runnable_impl),
+                nullptr),
+            nullptr);
+  EXPECT_EQ(invocations, 1);
+
+  auto identity = [](jobject arg) { return arg; };
+  NativeCallbackImpl<decltype(identity)> identity_impl{identity};
+
+  EXPECT_EQ(NativeCallbackClass::Invoke(env_.get(), nullptr,
+                                        reinterpret_cast<jlong>(&identity_impl),
+                                        Fake<jobject>()),
+            Fake<jobject>());
+}
+
+TEST_F(JniTest, NativeCallback_ReleasesReturnedLocalObjects) {
+  static constexpr jni::Class kClass{"kClass"};
+  auto function = [](jobject) {
+    return LocalObject<kClass>{jni::AdoptLocal{}, Fake<jobject>()};
+  };
+  NativeCallbackImpl<decltype(function)> function_impl{function};
+
+  EXPECT_CALL(*env_, DeleteLocalRef).Times(0);
+
+  EXPECT_EQ(NativeCallbackClass::Invoke(env_.get(), nullptr,
+                                        reinterpret_cast<jlong>(&function_impl),
+                                        nullptr),
+            Fake<jobject>());
+}
+
+TEST_F(JniTest, NativeCallback_ThrowsIfInvokedAfterDestruction) {
+  EXPECT_CALL(*env_, ThrowNew(_, StrEq("NativeCallback invoked after it was "
+                                       "destroyed.")));
+
+  EXPECT_EQ(NativeCallbackClass::Invoke(env_.get(), nullptr, 0, nullptr),
+            nullptr);
+}
+
+TEST_F(JniTest, NativeCallback_CompilesForAllInterfaces) {
+  ON_CALL(*env_, DefineClass).WillByDefault(Return(Fake<jclass>()));
+
+  NativeCallback<kJavaUtilFunctionConsumer> consumer{[](jobject) {}};
+  NativeCallback<kJavaUtilFunctionFunction> function{
+      [](jobject arg) { return arg; }};
+  NativeCallback<jni::kJavaUtilFunctionSupplier> supplier{
+      []() -> jobject { return nullptr; }};
+
+  EXPECT_NE(static_cast<jobject>(consumer), nullptr);
+  EXPECT_NE(static_cast<jobject>(function.Get()), nullptr);
+}
+
+}  // namespace
@@ -0,0 +1,447 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_NATIVE_ENTRY_H_
+#define JNI_BIND_IMPLEMENTATION_NATIVE_ENTRY_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "implementation/array_ref_view.h"
+#include "implementation/array_view.h"
+#include "implementation/class_ref.h"
+#include "implementation/default_class_loader.h"
+#include "implementation/jni_helper/jni_array_helper.h"
+#include "implementation/jni_helper/jni_env.h"
+#include "implementation/jni_helper/jni_helper.h"
+#include "implementation/jni_helper/jni_typename_to_string.h"
+#include "implementation/jni_type.h"
+#include "implementation/jvm.h"
+#include "implementation/local_array.h"
+#include "implementation/local_object.h"
+#include "implementation/local_string.h"
+#include "implementation/name_constants.h"
+#include "implementation/object_view.h"
+#include "implementation/string_view.h"
+#include "jni_dep.h"
+#include "metaprogramming/name_constants.h"
+#include "metaprogramming/string_concatenate.h"
+
+namespace jni {
+
+// A Java exception to throw when returning from a native entry, e.g.
+//   return jni::Exception{"java/lang/IllegalArgumentException", "Bad input."};
+struct Exception {
+  const char* class_name_;
+  std::string message_;
+};
+
+// Either the return value of a native entry (see `NativeEntry`) or an
+// `Exception` to throw in its place.
+template <typename T = void>
+class Result {
+ public:
+  Result(T value) : value_(std::move(value)) {}
+  Result(Exception exception) : exception_(std::move(exception)) {}
+
+  bool ok() const { return !exception_.has_value(); }
+
+  T& value() { return *value_; }
+  const Exception& exception() const { return *exception_; }
+
+ private:
+  std::optional<T> value_;
+  std::optional<Exception> exception_;
+};
+
+template <>
+class Result<void> {
+ public:
+  Result() = default;
+  Result(Exception exception) : exception_(std::move(exception)) {}
+
+  bool ok() const { return !exception_.has_value(); }
+
+  const Exception& exception() const { return *exception_; }
+
+ private:
+  std::optional<Exception> exception_;
+};
+
+//==============================================================================
+
+// Installs the `JNIEnv*` passed to a native entry as the thread's env. Threads
+// calling into native are always attached, so no `ThreadGuard` is needed.
+struct NativeEntryEnv {
+  static void Set(JNIEnv* env) { JniEnv::SetEnv(env); }
+
+  static void Throw(JNIEnv* env, const Exception& exception) {
+    // On failure `NoClassDefFoundError` is already pending.
+    if (jclass clazz = env->FindClass(exception.class_name_)) {
+      env->ThrowNew(clazz, exception.message_.c_str());
+      env->DeleteLocalRef(clazz);
+    }
+  }
+};
+
+// Converts a JNI argument of a native entry into the parameter type of the
+// C++ function. Holders live for the duration of the call, so anything they
+// pin or copy is released after the function returns.
+//
+// Unsupported parameter types fail to compile.
+template <typename T, typename Enable = void>
+struct NativeArg;
+
+template <typename T>
+inline constexpr bool kIsNativePrimitive =
+    std::is_same_v<T, jboolean> || std::is_same_v<T, jbyte> ||
+    std::is_same_v<T, jchar> || std::is_same_v<T, jshort> ||
+    std::is_same_v<T, jint> || std::is_same_v<T, jlong> ||
+    std::is_same_v<T, jfloat> || std::is_same_v<T, jdouble>;
+
+template <typename T>
+struct PrimitiveArraySignature {
+  static constexpr std::string_view kElement = JavaTypeToString<T>();
+  static constexpr std::string_view val = metaprogramming::StringConcatenate_v<
+      metaprogramming::Constants::left_bracket, kElement>;
+};
+
+template <const auto& class_v>
+struct ObjectSignature {
+  static constexpr std::string_view val = metaprogramming::StringConcatenate_v<
+      metaprogramming::Constants::L, NameOrNothing<class_v>::val,
+      metaprogramming::Constants::semi_colon>;
+};
+
+template <typename T>
+struct NativeArg<T, std::enable_if_t<kIsNativePrimitive<T>>> {
+  using JniType = T;
+  static constexpr std::string_view kSignature = JavaTypeToString<T>();
+
+  explicit NativeArg(T val) : val_(val) {}
+  T Get() { return val_; }
+
+  const T val_;
+};
+
+template <const auto& class_v, const auto& class_loader_v, const auto& jvm_v>
+struct NativeArg<ObjectView<class_v, class_loader_v, jvm_v>> {
+  using JniType = jobject;
+  static constexpr std::string_view kSignature = ObjectSignature<class_v>::val;
+
+  explicit NativeArg(jobject object) : object_(object) {}
+  ObjectView<class_v, class_loader_v, jvm_v> Get() { return {object_}; }
+
+  const jobject object_;
+};
+
+template <>
+struct NativeArg<StringView> {
+  using JniType = jstring;
+  static constexpr std::string_view kSignature = JavaTypeToString<jstring>();
+
+  explicit NativeArg(jstring str) : str_(str) {}
+  StringView Get() { return {str_}; }
+
+  const jstring str_;
+};
+
+// Strings are copied with `GetStringUTFRegion` rather than pinned.  Short
+// strings (the common case) are copied onto the stack.
+template <>
+struct NativeArg<std::string_view> {
+  using JniType = jstring;
+  static constexpr std::string_view kSignature = JavaTypeToString<jstring>();
+  static constexpr std::size_t kStackBufferSize = 256;
+
+  explicit NativeArg(jstring str) {
+    if (str == nullptr) {
+      return;
+    }
+
+    const jsize utf_len = JniHelper::GetStringUTFLength(str);
+    char* buf = stack_buffer_;
+    if (static_cast<std::size_t>(utf_len) >= kStackBufferSize) {
+      heap_buffer_.resize(utf_len + 1);
+      buf = heap_buffer_.data();
+    }
+
+    JniHelper::GetStringUTFRegion(str, 0, JniHelper::GetStringLength(str),
+                                  buf);
+    view_ = {buf, static_cast<std::size_t>(utf_len)};
+  }
+
+  NativeArg(const NativeArg&) = delete;
+
+  std::string_view Get() { return view_; }
+
+  char stack_buffer_[kStackBufferSize];
+  std::string heap_buffer_;
+  std::string_view view_;
+};
+
+template <typename SpanType>
+struct NativeArg<ArrayRefView<SpanType>,
+                 std::enable_if_t<kIsNativePrimitive<SpanType>>> {
+  using JniType = typename LocalArray<SpanType>::StorageType;
+  static constexpr std::string_view kSignature =
+      PrimitiveArraySignature<SpanType>::val;
+
+  explicit NativeArg(JniType array) : array_(array) {}
+  ArrayRefView<SpanType> Get() { return ArrayRefView<SpanType>{array_}; }
+
+  const JniType array_;
+};
+
+// Pinned primitive arrays. A `const ArrayView&` parameter is released with
+// `JNI_ABORT` (no copy back), a mutable one copies its writes back.  Like
+// `std::string_view`, a null array is passed as an empty view.
+template <typename SpanType, typename ViewRef>
+struct NativeArrayViewArg {
+  using JniType = typename LocalArray<SpanType>::StorageType;
+  static constexpr std::string_view kSignature =
+      PrimitiveArraySignature<SpanType>::val;
+  static constexpr bool kCopyOnCompletion =
+      !std::is_const_v<std::remove_reference_t<ViewRef>>;
+
+  explicit NativeArrayViewArg(JniType array)
+      : view_(array, kCopyOnCompletion,
+              array == nullptr
+                  ? 0
+                  : JniArrayHelper<SpanType, 1>::GetLength(array)) {}
+
+  ViewRef Get() { return view_; }
+
+  ArrayView<SpanType, 1> view_;
+};
+
+template <typename SpanType>
+struct NativeArg<const ArrayView<SpanType, 1>&,
+                 std::enable_if_t<kIsNativePrimitive<SpanType>>>
+    : NativeArrayViewArg<SpanType, const ArrayView<SpanType, 1>&> {
+  using NativeArrayViewArg<SpanType,
+                           const ArrayView<SpanType, 1>&>::NativeArrayViewArg;
+};
+
+template <typename SpanType>
+struct NativeArg<ArrayView<SpanType, 1>&,
+                 std::enable_if_t<kIsNativePrimitive<SpanType>>>
+    : NativeArrayViewArg<SpanType, ArrayView<SpanType, 1>&> {
+  using NativeArrayViewArg<SpanType,
+                           ArrayView<SpanType, 1>&>::NativeArrayViewArg;
+};
+
+//==============================================================================
+
+// Converts the return value of the C++ function of a native entry into its
+// JNI return. Objects are released to the caller, and failed `Result`s throw.
+template <typename T, typename Enable = void>
+struct NativeReturn;
+
+template <>
+struct NativeReturn<void> {
+  using JniType = void;
+  static constexpr std::string_view kSignature = JavaTypeToString<void>();
+
+  template <typename Func>
+  static void Invoke(JNIEnv*, Func&& func) {
+    func();
+  }
+};
+
+template <typename T>
+struct NativeReturn<T, std::enable_if_t<kIsNativePrimitive<T>>> {
+  using JniType = T;
+  static constexpr std::string_view kSignature = JavaTypeToString<T>();
+
+  template <typename Func>
+  static T Invoke(JNIEnv*, Func&& func) {
+    return func();
+  }
+};
+
+// Local objects, strings and arrays.
+template <typename T>
+struct NativeReleasedReturn {
+  using JniType = decltype(std::declval<T&>().Release());
+
+  template <typename Func>
+  static JniType Invoke(JNIEnv*, Func&& func) {
+    return func().Release();
+  }
+};
+
+template <const auto& class_v, const auto& class_loader_v, const auto& jvm_v>
+struct NativeReturn<LocalObject<class_v, class_loader_v, jvm_v>>
+    : NativeReleasedReturn<LocalObject<class_v, class_loader_v, jvm_v>> {
+  static constexpr std::string_view kSignature = ObjectSignature<class_v>::val;
+};
+
+template <>
+struct NativeReturn<LocalString> : NativeReleasedReturn<LocalString> {
+  static constexpr std::string_view kSignature = JavaTypeToString<jstring>();
+};
+
+template <typename SpanType>
+struct NativeReturn<LocalArray<SpanType>,
+                    std::enable_if_t<kIsNativePrimitive<SpanType>>>
+    : NativeReleasedReturn<LocalArray<SpanType>> {
+  static constexpr std::string_view kSignature =
+      PrimitiveArraySignature<SpanType>::val;
+};
+
+template <typename T>
+struct NativeReturn<Result<T>> {
+  using JniType = typename NativeReturn<T>::JniType;
+  static constexpr std::string_view kSignature = NativeReturn<T>::kSignature;
+
+  template <typename Func>
+  static JniType Invoke(JNIEnv* env, Func&& func) {
+    Result<T> result = func();
+
+    if (!result.ok()) {
+      NativeEntryEnv::Throw(env, result.exception());
+      if constexpr (!std::is_void_v<JniType>) {
+        return JniType{};
+      } else {
+        return;
+      }
+    }
+
+    if constexpr (!std::is_void_v<JniType>) {
+      return NativeReturn<T>::Invoke(
+          env, [&]() -> T&& { return std::move(result.value()); });
+    }
+  }
+};
+
+//==============================================================================
+
+template <auto fn, typename Fn, std::size_t kLocalFrameCapacity>
+struct NativeEntryImpl;
+
+template <auto fn, typename R, typename... Args,
+          std::size_t kLocalFrameCapacity>
+struct NativeEntryImpl<fn, R (*)(Args...), kLocalFrameCapacity> {
+  using Return = NativeReturn<R>;
+  using JniReturn = typename Return::JniType;
+
+  // The JNI signature of the entry, e.g. "(ILjava/lang/String;)[I".
+  static constexpr std::string_view kSignature =
+      metaprogramming::StringConcatenate_v<
+          metaprogramming::Constants::left_parenthesis,
+          NativeArg<Args>::kSignature...,
+          metaprogramming::Constants::right_parenthesis, Return::kSignature>;
+
+  // The JNI function. The receiver (`this` or the class for static natives)
+  // is not forwarded to |fn|.
+  static JniReturn JNICALL Call(JNIEnv* env, jobject,
+                                typename NativeArg<Args>::JniType... args) {
+    NativeEntryEnv::Set(env);
+
+    if constexpr (kLocalFrameCapacity == 0) {
+      return Invoke(env, args...);
+    } else {
+      // On failure `OutOfMemoryError` is pending.
+      if (JniHelper::PushLocalFrame(kLocalFrameCapacity) != 0) {
+        if constexpr (!std::is_void_v<JniReturn>) {
+          return JniReturn{};
+        } else {
+          return;
+        }
+      }
+
+      if constexpr (std::is_void_v<JniReturn>) {
+        Invoke(env, args...);
+        JniHelper::PopLocalFrame(nullptr);
+      } else if constexpr (std::is_pointer_v<JniReturn>) {
+        // The returned local is moved into the caller's frame.
+        return static_cast<JniReturn>(
+            JniHelper::PopLocalFrame(Invoke(env, args...)));
+      } else {
+        JniReturn ret = Invoke(env, args...);
+        JniHelper::PopLocalFrame(nullptr);
+        return ret;
+      }
+    }
+  }
+
+  // For `RegisterNatives`, |name| is the Java method name.
+  static JNINativeMethod Method(const char* name) {
+    return {const_cast<char*>(name), const_cast<char*>(kSignature.data()),
+            reinterpret_cast<void*>(&Call)};
+  }
+
+ private:
+  static JniReturn Invoke(JNIEnv* env,
+                          typename NativeArg<Args>::JniType... args) {
+    std::tuple<NativeArg<Args>...> holders{args...};
+
+    return Return::Invoke(env, [&holders]() -> decltype(auto) {
+      return std::apply(
+          [](auto&... holder) -> decltype(auto) { return fn(holder.Get()...); },
+          holders);
+    });
+  }
+};
+
+// Adapts a C++ function taking JNI Bind types into a JNI native method, e.g.
+//
+//   jni::LocalArray<jint> Scale(jni::ObjectView<kFoo> foo,
+//                               const jni::ArrayView<jint>& values,
+//                               std::string_view label);
+//
+//   jni::RegisterNatives<kFoo>({JNI_BIND_NATIVE(Scale)});
+//
+// or from a hand written `Java_...` function:
+//
+//   return jni::NativeEntry<&Scale>::Call(env, self, foo, values, label);
+//
+// Parameters may be primitives, `ObjectView`, `StringView`, rank 1 primitive
+// `ArrayRefView`, a pinned `[const] ArrayView<T>&` or a `std::string_view`
+// (copied, stack allocated when short).  Returns may be void, primitives,
+// `LocalObject`, `LocalString`, rank 1 primitive `LocalArray`, or a `Result`
+// of one of these (which throws its `Exception` on failure).
+//
+// No references are created for arguments, and the `JNIEnv*` of the call is
+// used directly. If |kLocalFrameCapacity| is non-zero, |fn| runs inside its
+// own local frame (so it needn't delete its locals).
+template <auto fn, std::size_t kLocalFrameCapacity = 0>
+struct NativeEntry
+    : NativeEntryImpl<fn, decltype(fn), kLocalFrameCapacity> {};
+
+// Binds |methods| (e.g. from `JNI_BIND_NATIVE`) to |class_v|. 0 is success.
+template <const auto& class_v, const auto& class_loader_v = kDefaultClassLoader,
+          const auto& jvm_v = kDefaultJvm>
+jint RegisterNatives(std::initializer_list<JNINativeMethod> methods) {
+  return JniHelper::RegisterNatives(
+      ClassRef_t<JniT<jobject, class_v, class_loader_v,
+                      jvm_v>>::GetAndMaybeLoadClassRef(nullptr),
+      methods.begin(), static_cast<jint>(methods.size()));
+}
+
+}  // namespace jni
+
+// A `JNINativeMethod` for `fn`, whose name must match the Java method's.
+#define JNI_BIND_NATIVE(fn) ::jni::NativeEntry<&fn>::Method(#fn)
+
+#endif  // JNI_BIND_IMPLEMENTATION_NATIVE_ENTRY_H_
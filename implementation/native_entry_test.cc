@@ -0,0 +1,189 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::ArrayView;
+using ::jni::Class;
+using ::jni::Exception;
+using ::jni::Fake;
+using ::jni::LocalArray;
+using ::jni::LocalObject;
+using ::jni::Method;
+using ::jni::NativeEntry;
+using ::jni::ObjectView;
+using ::jni::Params;
+using ::jni::Result;
+using ::jni::Return;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::StrEq;
+
+static constexpr Class kClass{
+    "kClass",
+    Method{"Foo", Return<jint>{}, Params<>{}},
+};
+
+jint Doubled(jint val) { return val * 2; }
+
+jint CallsFoo(ObjectView<kClass> obj) { return obj("Foo"); }
+
+std::string last_label;
+void Label(std::string_view label) { last_label = std::string{label}; }
+
+jint Sum(const ArrayView<jint>& values) {
+  jint sum = 0;
+  for (jint val : values) {
+    sum += val;
+  }
+  return sum;
+}
+
+LocalObject<kClass> Make() { return LocalObject<kClass>{}; }
+
+Result<jint> Fails() {
+  return Exception{"java/lang/IllegalStateException", "Bad state."};
+}
+
+Result<jint> Succeeds() { return 5; }
+
+LocalArray<jint> Scale(ObjectView<kClass>, const ArrayView<jint>&,
+                       std::string_view) {
+  return LocalArray<jint>{Fake<jintArray>()};
+}
+
+TEST_F(JniTest, NativeEntry_BuildsSignatures) {
+  EXPECT_EQ(NativeEntry<&Doubled>::kSignature, "(I)I");
+  EXPECT_EQ(NativeEntry<&Label>::kSignature, "(Ljava/lang/String;)V");
+  EXPECT_EQ(NativeEntry<&Make>::kSignature, "()LkClass;");
+  EXPECT_EQ(NativeEntry<&Fails>::kSignature, "()I");
+  EXPECT_EQ(NativeEntry<&Scale>::kSignature,
+            "(LkClass;[ILjava/lang/String;)[I");
+}
+
+TEST_F(JniTest, NativeEntry_ForwardsPrimitives) {
+  EXPECT_EQ(NativeEntry<&Doubled>::Call(env_.get(), Fake<jobject>(), 21), 42);
+}
+
+TEST_F(JniTest, NativeEntry_BorrowsObjects) {
+  EXPECT_CALL(*env_, NewLocalRef).Times(0);
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jobject>(2))).Times(0);
+  EXPECT_CALL(*env_, CallIntMethodV(Fake<jobject>(2), _, _))
+      .WillOnce(testing::Return(7));
+
+  EXPECT_EQ(NativeEntry<&CallsFoo>::Call(env_.get(), Fake<jobject>(),
+                                         Fake<jobject>(2)),
+            7);
+}
+
+TEST_F(JniTest, NativeEntry_CopiesStringsWithoutPinning) {
+  EXPECT_CALL(*env_, GetStringUTFChars).Times(0);
+  EXPECT_CALL(*env_, GetStringUTFLength(Fake<jstring>()))
+      .WillOnce(testing::Return(5));
+  EXPECT_CALL(*env_, GetStringLength(Fake<jstring>()))
+      .WillOnce(testing::Return(5));
+  EXPECT_CALL(*env_, GetStringUTFRegion(Fake<jstring>(), 0, 5, _))
+      .WillOnce([](jstring, jsize, jsize, char* buf) {
+        std::memcpy(buf, "hello", 6);
+      });
+
+  NativeEntry<&Label>::Call(env_.get(), Fake<jobject>(), Fake<jstring>());
+  EXPECT_EQ(last_label, "hello");
+}
+
+TEST_F(JniTest, NativeEntry_ConstArrayViewsAreReleasedWithoutCopyBack) {
+  jint values[] = {1, 2, 3};
+
+  EXPECT_CALL(*env_, GetArrayLength(Fake<jintArray>()))
+      .WillOnce(testing::Return(3));
+  EXPECT_CALL(*env_, GetIntArrayElements(Fake<jintArray>(), _))
+      .WillOnce(testing::Return(values));
+  EXPECT_CALL(*env_,
+              ReleaseIntArrayElements(Fake<jintArray>(), values, JNI_ABORT));
+
+  EXPECT_EQ(NativeEntry<&Sum>::Call(env_.get(), Fake<jobject>(),
+                                    Fake<jintArray>()),
+            6);
+}
+
+TEST_F(JniTest, NativeEntry_NullArraysAreEmptyViews) {
+  EXPECT_CALL(*env_, GetArrayLength).Times(0);
+  EXPECT_CALL(*env_, GetIntArrayElements).Times(0);
+  EXPECT_CALL(*env_, ReleaseIntArrayElements).Times(0);
+
+  EXPECT_EQ(NativeEntry<&Sum>::Call(env_.get(), Fake<jobject>(),
+                                    static_cast<jintArray>(nullptr)),
+            0);
+}
+
+TEST_F(JniTest, NativeEntry_ReleasesReturnedObjects) {
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jobject>())).Times(0);
+
+  EXPECT_EQ(NativeEntry<&Make>::Call(env_.get(), Fake<jobject>(2)),
+            Fake<jobject>());
+}
+
+TEST_F(JniTest, NativeEntry_ThrowsFailedResults) {
+  EXPECT_CALL(*env_, FindClass(StrEq("java/lang/IllegalStateException")))
+      .WillOnce(testing::Return(Fake<jclass>(2)));
+  EXPECT_CALL(*env_, ThrowNew(Fake<jclass>(2), StrEq("Bad state.")));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jclass>(2)));
+
+  EXPECT_EQ(NativeEntry<&Fails>::Call(env_.get(), Fake<jobject>()), 0);
+}
+
+TEST_F(JniTest, NativeEntry_UnwrapsSuccessfulResults) {
+  EXPECT_CALL(*env_, ThrowNew).Times(0);
+
+  EXPECT_EQ(NativeEntry<&Succeeds>::Call(env_.get(), Fake<jobject>()), 5);
+}
+
+TEST_F(JniTest, NativeEntry_LocalFrameMovesReturnToCallerFrame) {
+  EXPECT_CALL(*env_, PushLocalFrame(16)).WillOnce(testing::Return(0));
+  EXPECT_CALL(*env_, PopLocalFrame(Fake<jobject>()))
+      .WillOnce(testing::Return(Fake<jobject>(3)));
+
+  EXPECT_EQ((NativeEntry<&Make, 16>::Call(env_.get(), Fake<jobject>(2))),
+            Fake<jobject>(3));
+}
+
+TEST_F(JniTest, NativeEntry_RegistersNatives) {
+  EXPECT_CALL(*env_, RegisterNatives(_, _, 2))
+      .WillOnce([](jclass, const JNINativeMethod* methods, jint) {
+        EXPECT_STREQ(methods[0].name, "Doubled");
+        EXPECT_STREQ(methods[0].signature, "(I)I");
+        EXPECT_EQ(methods[0].fnPtr,
+                  reinterpret_cast<void*>(&NativeEntry<&Doubled>::Call));
+        EXPECT_STREQ(methods[1].name, "Scale");
+        return 0;
+      });
+
+  EXPECT_EQ(jni::RegisterNatives<kClass>(
+                {JNI_BIND_NATIVE(Doubled), JNI_BIND_NATIVE(Scale)}),
+            0);
+}
+
+}  // namespace
@@ -34,6 +34,7 @@
 #include "implementation/method_selection.h"
 #include "implementation/proxy.h"
 #include "implementation/ref_base.h"
+#include "implementation/super_ref.h"
 #include "jni_dep.h"
 #include "metaprogramming/invocable_map.h"
 #include "metaprogramming/optional_wrap.h"
@@ -99,6 +100,7 @@ class ObjectRef
     static_assert(MethodSelectionForArgs::kIsValidArgSet,
                   "JNI Error: Invalid argument set.");
 
+    RefBase::CheckThread("Local reference used on another thread");
     return MethodSelectionForArgs::OverloadRef::Invoke(
         GetJClass(), RefBase::object_ref_, std::forward<Args>(args)...);
   }
@@ -106,8 +108,22 @@ class ObjectRef
   // Invoked through CRTP from QueryableMap.
   template <size_t I>
   auto QueryableMapCall(const char* key) const {
+    RefBase::CheckThread("Local reference used on another thread");
     return FieldRef<JniT, IdType::FIELD, I>{GetJClass(), RefBase::object_ref_};
   }
+
+  // Calls |parent_class_v|'s implementation of a method, skipping any override
+  // (i.e. `super.Foo()`), e.g. `obj.Super<kParent>()("Foo")`.
+  //
+  // |parent_class_v| must be a superclass of this object's class and must be
+  // available to the same class loader.
+  template <const auto& parent_class_v>
+  auto Super() const {
+    using ParentJniT = ::jni::JniT<jobject, parent_class_v,
+                                   JniT::class_loader_v, JniT::jvm_v>;
+
+    return SuperRef<ParentJniT>{static_cast<jobject>(RefBase::object_ref_)};
+  }
 };
 
 // Imbues constructors for ObjectRefs and handles calling the correct
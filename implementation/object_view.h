@@ -0,0 +1,53 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_OBJECT_VIEW_H_
+#define JNI_BIND_OBJECT_VIEW_H_
+
+#include "implementation/default_class_loader.h"
+#include "implementation/jni_type.h"
+#include "implementation/jvm.h"
+#include "implementation/object_ref.h"
+#include "implementation/ref_base.h"
+#include "jni_dep.h"
+
+namespace jni {
+
+// A borrowed (non-owning) object, e.g. an argument of a native method.
+//
+// `LocalObject<kClass>{obj}` makes a new local reference (and deletes it when
+// it leaves scope) so that it is never responsible for the caller's reference.
+// An `ObjectView` makes no JNI calls at all, but |object| must outlive it,
+// e.g. it is only valid for the duration of the native call it came from.
+//
+// Methods and fields are accessed just like with `LocalObject`.
+template <const auto& class_v_,
+          const auto& class_loader_v_ = kDefaultClassLoader,
+          const auto& jvm_v_ = kDefaultJvm>
+class ObjectView
+    : public ObjectRef<JniT<jobject, class_v_, class_loader_v_, jvm_v_>> {
+ public:
+  using Base = ObjectRef<JniT<jobject, class_v_, class_loader_v_, jvm_v_>>;
+
+  ObjectView(jobject object) : Base(RefBaseTag<jobject>{object}) {}
+
+  ObjectView(const ObjectView& rhs)
+      : Base(RefBaseTag<jobject>{static_cast<jobject>(rhs)}) {}
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_OBJECT_VIEW_H_
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Class;
+using ::jni::Fake;
+using ::jni::Field;
+using ::jni::Method;
+using ::jni::ObjectView;
+using ::jni::Params;
+using ::jni::Return;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::StrEq;
+
+static constexpr Class kClass2{"kClass2"};
+
+static constexpr Class kClass{
+    "kClass",
+    Method{"Foo", Return<jint>{}, Params<>{}},
+    Method{"TakesObj", Return<void>{}, Params{kClass2}},
+    Field{"intVal", jint{}},
+};
+
+TEST_F(JniTest, ObjectView_MakesNoReferenceCalls) {
+  EXPECT_CALL(*env_, NewLocalRef).Times(0);
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jobject>())).Times(0);
+
+  ObjectView<kClass> obj{Fake<jobject>()};
+  EXPECT_EQ(static_cast<jobject>(obj), Fake<jobject>());
+}
+
+TEST_F(JniTest, ObjectView_CopiesAreAlsoBorrowed) {
+  EXPECT_CALL(*env_, NewLocalRef).Times(0);
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jobject>())).Times(0);
+
+  ObjectView<kClass> obj{Fake<jobject>()};
+  ObjectView<kClass> obj2{obj};
+  EXPECT_EQ(static_cast<jobject>(obj2), Fake<jobject>());
+}
+
+TEST_F(JniTest, ObjectView_CallsMethodsOnTheBorrowedObject) {
+  EXPECT_CALL(*env_, GetMethodID(_, StrEq("Foo"), StrEq("()I")));
+  EXPECT_CALL(*env_, CallIntMethodV(Fake<jobject>(), _, _))
+      .WillOnce(testing::Return(123));
+
+  ObjectView<kClass> obj{Fake<jobject>()};
+  EXPECT_EQ(obj("Foo"), 123);
+}
+
+TEST_F(JniTest, ObjectView_AccessesFieldsOnTheBorrowedObject) {
+  EXPECT_CALL(*env_, GetFieldID(_, StrEq("intVal"), StrEq("I")));
+  EXPECT_CALL(*env_, GetIntField(Fake<jobject>(), _))
+      .WillOnce(testing::Return(5));
+  EXPECT_CALL(*env_, SetIntField(Fake<jobject>(), _, 6));
+
+  ObjectView<kClass> obj{Fake<jobject>()};
+  obj["intVal"].Set(obj["intVal"].Get() + 1);
+}
+
+TEST_F(JniTest, ObjectView_CanBePassedAsAnArgument) {
+  EXPECT_CALL(*env_, CallVoidMethodV(Fake<jobject>(1), _, _));
+
+  ObjectView<kClass> obj{Fake<jobject>(1)};
+  ObjectView<kClass2> arg{Fake<jobject>(2)};
+  obj("TakesObj", arg);
+}
+
+}  // namespace
@@ -25,8 +25,10 @@
 #include "implementation/class_ref.h"
 #include "implementation/default_class_loader.h"
 #include "implementation/id_type.h"
+#include "implementation/jfr_events.h"
 #include "implementation/jni_helper/invoke.h"
 #include "implementation/jni_helper/invoke_static.h"
+#include "implementation/jni_helper/invoke_trampoline.h"
 #include "implementation/jni_helper/jni_env.h"
 #include "implementation/jni_helper/jni_helper.h"
 #include "implementation/jni_helper/lifecycle_object.h"
@@ -80,33 +82,41 @@ struct OverloadRef {
       Return_t<typename SelfIdT::MaterializeCDeclT, SelfIdT>,
       Return_t<typename ReturnIdT::MaterializeCDeclT, ReturnIdT> >;
 
+  // Method IDs are cached against the `JvmEpoch`. |clazz| is captured per
+  // call as the jclass is itself reloaded after a JvmRef restart.
   static jmethodID GetMethodID(jclass clazz) {
-    static auto get_lambda =
-        [clazz](metaprogramming::DoubleLockedValue<jmethodID>* storage) {
-          DefaultRefs<jmethodID>().push_back(storage);
-
-          if constexpr (IdT::kIsStatic) {
-            return jni::JniHelper::GetStaticMethodID(clazz, IdT::Name(),
-                                                     Signature_v<IdT>.data());
-          } else {
-            return jni::JniHelper::GetMethodID(clazz, IdT::Name(),
-                                               Signature_v<IdT>.data());
-          }
-        };
-
-    return RefStorage<decltype(get_lambda), OverloadRefUniqueId<IdT>>::Get(
-        get_lambda);
+    auto get_lambda = [clazz]() {
+      if constexpr (IdT::kIsStatic) {
+        return jni::JniHelper::GetStaticMethodID(clazz, IdT::Name(),
+                                                 Signature_v<IdT>.data());
+      } else {
+        return jni::JniHelper::GetMethodID(clazz, IdT::Name(),
+                                           Signature_v<IdT>.data());
+      }
+    };
+
+    return EpochRefStorage<decltype(get_lambda),
+                           OverloadRefUniqueId<IdT>>::Get(get_lambda);
   }
 
-  template <typename... Params>
+  // Non-virtual calls (see `Nonvirtual`) use `CallNonvirtual<T>Method`.
+  template <typename CDecl, bool kNonvirtual>
+  using Dispatch_t = InvokeDispatch<CDecl, ReturnIdT::kRank,
+                                    ReturnIdT::kIsStatic, kNonvirtual>;
+
+  // |kNonvirtual| may be forced for calls to a parent implementation (see
+  // `SuperRef`), in which case |clazz| must be the parent class.
+  template <bool kNonvirtual = IdT::kIsNonvirtual, typename... Params>
   static ReturnProxied Invoke(jclass clazz, jobject object,
                               Params&&... params) {
-    constexpr std::size_t kRank = ReturnIdT::kRank;
-    constexpr bool kStatic = ReturnIdT::kIsStatic;
+    static_assert(!(kNonvirtual && ReturnIdT::kIsStatic),
+                  "Static methods are never virtual, they can't be tagged "
+                  "Nonvirtual or called through Super.");
     const jmethodID mthd = OverloadRef::GetMethodID(clazz);
+    JfrInvocationScope<> jfr_scope{OverloadRefUniqueId<IdT>::TypeName()};
 
     if constexpr (std::is_same_v<ReturnProxied, void>) {
-      return InvokeHelper<void, kRank, kStatic>::Invoke(
+      return Dispatch_t<void, kNonvirtual>::Invoke(
           object, clazz, mthd,
           Proxy_t<Params>::ProxyAsArg(std::forward<Params>(params))...);
     } else if constexpr (IdT::kIsConstructor) {
@@ -116,17 +126,18 @@ struct OverloadRef {
               clazz, mthd,
               Proxy_t<Params>::ProxyAsArg(std::forward<Params>(params))...)};
     } else {
+      using Dispatch = Dispatch_t<typename ReturnIdT::CDecl, kNonvirtual>;
+
       if constexpr (std::is_base_of_v<RefBaseBase, ReturnProxied>) {
         return ReturnProxied{
             AdoptLocal{},
-            InvokeHelper<typename ReturnIdT::CDecl, kRank, kStatic>::Invoke(
+            Dispatch::Invoke(
                 object, clazz, mthd,
                 Proxy_t<Params>::ProxyAsArg(std::forward<Params>(params))...)};
       } else {
-        return static_cast<ReturnProxied>(
-            InvokeHelper<typename ReturnIdT::CDecl, kRank, kStatic>::Invoke(
-                object, clazz, mthd,
-                Proxy_t<Params>::ProxyAsArg(std::forward<Params>(params))...));
+        return static_cast<ReturnProxied>(Dispatch::Invoke(
+            object, clazz, mthd,
+            Proxy_t<Params>::ProxyAsArg(std::forward<Params>(params))...));
       }
     }
   }
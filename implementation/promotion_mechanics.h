@@ -47,8 +47,14 @@ struct EntryBase : public Base {
             typename = std::enable_if_t<
                 (::jni::metaprogramming::DeepEqualDiminished_v<EntryBase, T> ||
                  std::is_base_of_v<RefBaseTag<Span>, T>)>>
-  EntryBase(T&& rhs) : Base(rhs.Release()) {}
-  EntryBase(AdoptLocal, ViableSpan object) : Base(object) {}
+  EntryBase(T&& rhs) : Base(rhs.Release()) {
+    static_cast<const RefBaseTag<typename JniT::StorageType>&>(rhs)
+        .CheckThread("Local reference moved from another thread");
+    Base::ClaimThread();
+  }
+  EntryBase(AdoptLocal, ViableSpan object) : Base(object) {
+    Base::ClaimThread();
+  }
 
   // "Copy" constructor: Additional reference to object will be created.
   EntryBase(NewRef, ViableSpan object)
@@ -176,6 +182,7 @@ struct Scoped
  protected:
   void MaybeReleaseUnderlyingObject() {
     if (Base::object_ref_) {
+      Base::CheckThread("Local reference released on another thread");
       LifecycleHelper<typename JniT::StorageType, lifecycleType>::Delete(
           Base::object_ref_);
     }
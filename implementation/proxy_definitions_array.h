@@ -30,6 +30,10 @@ template <typename SpanType, std::size_t kRank, const auto& class_v_,
           const auto& class_loader_v_, const auto& jvm_v_>
 class LocalArray;
 
+template <typename SpanType, std::size_t kRank, const auto& class_v_,
+          const auto& class_loader_v_, const auto& jvm_v_>
+class ArrayRefView;
+
 template <typename JArrayType>
 struct Proxy<JArrayType, typename std::enable_if_t<
                              std::is_convertible_v<JArrayType, jarray>>>
@@ -61,6 +65,15 @@ struct Proxy<JArrayType, typename std::enable_if_t<
          (std::string_view{class_v_.name_} == NameOrNothing_v<param_copy>));
   };
 
+  // ArrayRefView (viable wherever the equivalent LocalArray is).
+  template <typename ParamSelection, typename SpanType, std::size_t kRank,
+            const auto& class_v_, const auto& class_loader_v_,
+            const auto& jvm_v_>
+  struct Helper<ParamSelection, ArrayRefView<SpanType, kRank, class_v_,
+                                             class_loader_v_, jvm_v_>>
+      : Helper<ParamSelection, LocalArray<SpanType, kRank, class_v_,
+                                          class_loader_v_, jvm_v_>> {};
+
   template <typename ParamSelection, typename T>
   static constexpr bool kViable = Helper<ParamSelection, T>::val;
 
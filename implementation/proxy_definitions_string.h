@@ -59,7 +59,8 @@ struct Proxy<JString,
       IsConvertibleKey<T>::template value<char*> ||
       IsConvertibleKey<T>::template value<const char*> ||
       IsConvertibleKey<T>::template value<std::string_view> ||
-      std::is_same_v<T, LocalString> || std::is_same_v<T, GlobalString>;
+      std::is_same_v<T, LocalString> || std::is_same_v<T, GlobalString> ||
+      std::is_same_v<T, StringView>;
 
   // These leak local instances of strings.  Usually, RAII mechanisms would
   // correctly release local instances, but here we are stripping that so it can
@@ -82,14 +83,16 @@ struct Proxy<JString,
 
   template <typename T,
             typename = std::enable_if_t<std::is_same_v<T, GlobalString> ||
-                                        std::is_same_v<T, LocalString>>>
+                                        std::is_same_v<T, LocalString> ||
+                                        std::is_same_v<T, StringView>>>
   static jstring ProxyAsArg(T& t) {
     return jstring{t};
   }
 
   template <typename T,
             typename = std::enable_if_t<std::is_same_v<T, GlobalString> ||
-                                        std::is_same_v<T, LocalString>>>
+                                        std::is_same_v<T, LocalString> ||
+                                        std::is_same_v<T, StringView>>>
   static jstring ProxyAsArg(T&& t) {
     return t.Release();
   }
@@ -21,6 +21,7 @@
 
 #include "implementation/class.h"
 #include "implementation/class_loader.h"
+#include "implementation/jni_helper/jni_check.h"
 #include "implementation/jni_helper/jni_env.h"
 #include "implementation/jni_helper/lifecycle.h"
 
@@ -31,8 +32,10 @@ struct RefBaseBase {};
 // Used to detect RefBase in type proxying.
 // This is useful, e.g. when you want to say "an object that might be passed"
 // but the object's type (i.e. full name + loader information) is unknown.
+//
+// Only local `Entry` types claim a thread (see `JniCheck`).
 template <typename StorageType>
-class RefBaseTag : public RefBaseBase {
+class RefBaseTag : public RefBaseBase, protected JniCheckThreadOwner<> {
  public:
   template <typename Base, LifecycleType lifecycleType, typename JniT,
             typename ViableSpan>
@@ -16,29 +16,105 @@
 #ifndef JNI_BIND_IMPLEMENTATION_REF_STORAGE_H_
 #define JNI_BIND_IMPLEMENTATION_REF_STORAGE_H_
 
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include "metaprogramming/double_locked_value.h"
+#include "metaprogramming/epoch_locked_value.h"
 #include "metaprogramming/lambda_string.h"
 
 namespace jni {
 
-// Used as shared storage of lists for IDs like jclass, jMethod, etc.
+// A list of cached values to be torn down by JvmRef::~JvmRef.
+//
+// Entries are pushed from inside a `DoubleLockedValue`'s init lambda, which
+// only holds that value's lock, so two different cold IDs may push at once.
+// The list therefore guards itself.
+template <typename T>
+class TeardownList {
+ public:
+  void push_back(T val) {
+    std::lock_guard<std::mutex> lock_guard{lock_};
+    list_.push_back(std::move(val));
+  }
+
+  // Empties the list, invoking |lambda| on every entry (without holding the
+  // lock, as tearing down an entry may itself take other locks).
+  template <typename Lambda>
+  void ForEachAndClear(Lambda&& lambda) {
+    std::vector<T> list;
+    {
+      std::lock_guard<std::mutex> lock_guard{lock_};
+      list.swap(list_);
+    }
+
+    for (T& val : list) {
+      lambda(val);
+    }
+  }
+
+  std::size_t size() {
+    std::lock_guard<std::mutex> lock_guard{lock_};
+    return list_.size();
+  }
+
+ private:
+  std::mutex lock_;
+  std::vector<T> list_;
+};
+
+// Used as shared storage of lists for IDs which hold resources, i.e. jclass.
 // Only applicable for Jvms not fully specified (i.e. default classloader).
 // See JvmRef::~JvmRef.
 template <typename T>
-static std::vector<metaprogramming::DoubleLockedValue<T>*>& DefaultRefs() {
+inline TeardownList<metaprogramming::DoubleLockedValue<T>*>& DefaultRefs() {
   static auto* ret_val =
-      new std::vector<metaprogramming::DoubleLockedValue<T>*>{};
+      new TeardownList<metaprogramming::DoubleLockedValue<T>*>{};
   return *ret_val;
 }
 
+// The generation of JVM that IDs like jmethodID and jfieldID are cached for.
+//
+// These IDs hold no resources, they need only be forgotten when the JVM goes
+// away. Rather than registering every cache for teardown, they are stored in
+// an `EpochLockedValue` against the epoch, and JvmRef::~JvmRef advances the
+// epoch in O(1). Stale IDs are re-resolved lazily on their next use.
+class JvmEpoch {
+ public:
+  static std::size_t Get() { return epoch_.load(std::memory_order_acquire); }
+
+  static void Advance() { epoch_.fetch_add(1, std::memory_order_acq_rel); }
+
+ private:
+  // Epochs start at 1, 0 is an uninitialised `EpochLockedValue`.
+  static inline std::atomic<std::size_t> epoch_{1};
+};
+
 // Provides a static inline `DoubleLockedValue<T>` val against a `UniqueID`.
 template <typename UniqueID, typename T>
 struct StaticDoubleLock {
   static inline metaprogramming::DoubleLockedValue<T> val;
 };
 
+// Provides a static inline `EpochLockedValue<T>` val against a `UniqueID`.
+template <typename UniqueID, typename T>
+struct StaticEpochLock {
+  static inline metaprogramming::EpochLockedValue<T> val;
+};
+
+// Converts `SignatureLambda`'s `TypeName` into a type usable as a unique ID.
+template <typename SignatureLambda>
+struct UniqueSignature {
+  static constexpr auto kSignature = []() {
+    return SignatureLambda::TypeName().data();
+  };
+
+  using type = metaprogramming::LambdaStringToType<decltype(kSignature)>;
+};
+
 // Takes a GetLambda and only invokes it for the first time on equal values of
 // `SignatureLambda`. This is useful for putting `const char*` into type IDs.
 template <typename GetLambda, typename SignatureLambda>
@@ -47,10 +123,7 @@ struct RefStorage {
   using ReturnT = decltype(std::declval<GetLambda>()(nullptr));
 
   // Compile-time unique ID.
-  static constexpr auto kSignature = []() {
-    return SignatureLambda::TypeName().data();
-  };
-  using Signature = metaprogramming::LambdaStringToType<decltype(kSignature)>;
+  using Signature = typename UniqueSignature<SignatureLambda>::type;
 
   // Common ID-wide double locked value.
   using Storage = StaticDoubleLock<Signature, ReturnT>;
@@ -62,6 +135,23 @@ struct RefStorage {
   }
 };
 
+// Like `RefStorage`, but for IDs that are only valid for the current
+// `JvmEpoch` (e.g. jmethodID). `GetLambda` takes no arguments.
+template <typename GetLambda, typename SignatureLambda>
+struct EpochRefStorage {
+  // Return of `GetLambda`.
+  using ReturnT = decltype(std::declval<GetLambda>()());
+
+  // Compile-time unique ID.
+  using Signature = typename UniqueSignature<SignatureLambda>::type;
+
+  // Retrieves the guarded value, possibly invoking the expensive lambda.
+  static ReturnT Get(GetLambda lambda) {
+    return StaticEpochLock<Signature, ReturnT>::val.LoadAndMaybeInit(
+        JvmEpoch::Get(), lambda);
+  }
+};
+
 }  // namespace jni
 
 #endif  // JNI_BIND_IMPLEMENTATION_REF_STORAGE_H_
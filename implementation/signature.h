@@ -99,7 +99,7 @@ struct Signature<Id<JniT_, kIdType_, idx, secondary_idx, tertiary_idx>> {
 };
 
 template <typename T>
-static constexpr auto Signature_v = Signature<T>::val;
+inline constexpr auto Signature_v = Signature<T>::val;
 
 }  // namespace jni
 
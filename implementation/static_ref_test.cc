@@ -26,6 +26,8 @@ using ::jni::Array;
 using ::jni::Class;
 using ::jni::Fake;
 using ::jni::Field;
+using ::jni::Final;
+using ::jni::JvmRef;
 using ::jni::LocalObject;
 using ::jni::LocalString;
 using ::jni::Method;
@@ -33,8 +35,11 @@ using ::jni::Params;
 using ::jni::Rank;
 using ::jni::Static;
 using ::jni::StaticRef;
+using ::jni::test::AsGlobal;
 using ::jni::test::JniTest;
+using ::jni::test::JniTestWithNoDefaultJvmRef;
 using ::testing::_;
+using ::testing::AnyNumber;
 using ::testing::Return;
 using ::testing::StrEq;
 
@@ -190,6 +195,81 @@ TEST_F(JniTest, StaticField_ObjectSet) {
       LocalObject<kClass2>{AdoptLocal{}, Fake<jobject>()});
 }
 
+// clang-format off
+static constexpr Class kFinalClass{
+  "kFinalClass",
+      Static {
+        Field{"MAX_BATCH", Final{}, jint{}},
+        Field{"ZERO", Final{}, jlong{}},
+        Field{"NAME", Final{}, jstring{}},
+        Field{"NO_NAME", Final{}, jstring{}},
+        Field{"notFinal", jint{}},
+      },
+};
+// clang-format on
+
+TEST_F(JniTest, StaticField_FinalPrimitivesAreReadOnce) {
+  EXPECT_CALL(*env_, GetStaticFieldID(_, StrEq("MAX_BATCH"), StrEq("I")))
+      .WillOnce(Return(Fake<jfieldID>()));
+  EXPECT_CALL(*env_, GetStaticIntField(_, Fake<jfieldID>()))
+      .WillOnce(Return(64));
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(StaticRef<kFinalClass>{}["MAX_BATCH"].Get(), 64);
+  }
+}
+
+TEST_F(JniTest, StaticField_FinalZeroIsCached) {
+  EXPECT_CALL(*env_, GetStaticLongField).WillOnce(Return(0));
+
+  EXPECT_EQ(StaticRef<kFinalClass>{}["ZERO"].Get(), 0);
+  EXPECT_EQ(StaticRef<kFinalClass>{}["ZERO"].Get(), 0);
+}
+
+TEST_F(JniTest, StaticField_NonFinalFieldsAreAlwaysRead) {
+  EXPECT_CALL(*env_, GetStaticIntField).WillOnce(Return(1)).WillOnce(Return(2));
+
+  EXPECT_EQ(StaticRef<kFinalClass>{}["notFinal"].Get(), 1);
+  EXPECT_EQ(StaticRef<kFinalClass>{}["notFinal"].Get(), 2);
+}
+
+TEST_F(JniTest, StaticField_FinalStringsAreHeldAsGlobals) {
+  EXPECT_CALL(*env_, GetStaticObjectField).WillOnce(Return(Fake<jstring>()));
+  EXPECT_CALL(*env_, NewGlobalRef(Fake<jstring>()));
+  EXPECT_CALL(*env_, NewLocalRef(AsGlobal(Fake<jstring>()))).Times(2);
+  EXPECT_CALL(*env_, DeleteGlobalRef(AsGlobal(Fake<jstring>())));
+
+  LocalString name_1 = StaticRef<kFinalClass>{}["NAME"].Get();
+  LocalString name_2 = StaticRef<kFinalClass>{}["NAME"].Get();
+}
+
+TEST_F(JniTest, StaticField_FinalNullStringIsCached) {
+  EXPECT_CALL(*env_, GetStaticObjectField).WillOnce(Return(nullptr));
+  EXPECT_CALL(*env_, NewGlobalRef(nullptr)).Times(0);
+  EXPECT_CALL(*env_, NewLocalRef(nullptr)).Times(0);
+
+  for (int i = 0; i < 3; ++i) {
+    LocalString name = StaticRef<kFinalClass>{}["NO_NAME"].Get();
+    EXPECT_EQ(static_cast<jstring>(name), nullptr);
+  }
+}
+
+TEST_F(JniTestWithNoDefaultJvmRef, StaticField_FinalsAreReadAgainPerJvmRef) {
+  EXPECT_CALL(*env_, DeleteGlobalRef).Times(AnyNumber());
+  EXPECT_CALL(*env_, GetStaticIntField).WillOnce(Return(1)).WillOnce(Return(2));
+
+  {
+    JvmRef<jni::kDefaultJvm> jvm_ref{jvm_.get()};
+    EXPECT_EQ(StaticRef<kFinalClass>{}["MAX_BATCH"].Get(), 1);
+    EXPECT_EQ(StaticRef<kFinalClass>{}["MAX_BATCH"].Get(), 1);
+  }
+
+  {
+    JvmRef<jni::kDefaultJvm> jvm_ref{jvm_.get()};
+    EXPECT_EQ(StaticRef<kFinalClass>{}["MAX_BATCH"].Get(), 2);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Static Methods.
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_STRING_VIEW_H_
+#define JNI_BIND_STRING_VIEW_H_
+
+#include "class_defs/java_lang_classes.h"
+#include "implementation/default_class_loader.h"
+#include "implementation/jni_type.h"
+#include "implementation/jvm.h"
+#include "implementation/object_ref.h"
+#include "implementation/ref_base.h"
+#include "implementation/string_ref.h"
+#include "jni_dep.h"
+
+namespace jni {
+
+// A borrowed (non-owning) jstring, e.g. an argument of a native method.
+//
+// Like `ObjectView`, this makes no `NewLocalRef` or `DeleteLocalRef` calls,
+// and |java_string| must outlive it. Unlike `LocalString`, it cannot build
+// new strings.
+class StringView
+    : public ObjectRef<
+          JniT<jstring, kJavaLangString, kDefaultClassLoader, kDefaultJvm>> {
+ public:
+  using Base = ObjectRef<
+      JniT<jstring, kJavaLangString, kDefaultClassLoader, kDefaultJvm>>;
+
+  StringView(jstring java_string) : Base(RefBaseTag<jstring>{java_string}) {}
+
+  StringView(const StringView& rhs)
+      : Base(RefBaseTag<jstring>{static_cast<jstring>(rhs)}) {}
+
+  // Returns a UtfStringView which possibly performs an expensive pinning
+  // operation.  String objects can be pinned multiple times.
+  UtfStringView Pin() { return {RefBaseTag<jstring>::object_ref_}; }
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_STRING_VIEW_H_
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Class;
+using ::jni::Fake;
+using ::jni::Method;
+using ::jni::ObjectView;
+using ::jni::Params;
+using ::jni::Return;
+using ::jni::StringView;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::StrEq;
+
+static constexpr Class kClass{
+    "kClass",
+    Method{"TakesString", Return<void>{}, Params<jstring>{}},
+};
+
+TEST_F(JniTest, StringView_MakesNoReferenceCalls) {
+  EXPECT_CALL(*env_, NewLocalRef).Times(0);
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jstring>())).Times(0);
+
+  StringView str{Fake<jstring>()};
+  EXPECT_EQ(static_cast<jstring>(str), Fake<jstring>());
+}
+
+TEST_F(JniTest, StringView_PinsTheBorrowedString) {
+  EXPECT_CALL(*env_, GetStringUTFChars(Fake<jstring>(), _))
+      .WillOnce(testing::Return("Foo"));
+  EXPECT_CALL(*env_, ReleaseStringUTFChars(Fake<jstring>(), StrEq("Foo")));
+
+  StringView str{Fake<jstring>()};
+  EXPECT_EQ(str.Pin().ToString(), "Foo");
+}
+
+TEST_F(JniTest, StringView_CanBePassedAsAnArgument) {
+  EXPECT_CALL(*env_, CallVoidMethodV(Fake<jobject>(), _, _));
+  EXPECT_CALL(*env_, DeleteLocalRef(Fake<jstring>())).Times(0);
+
+  ObjectView<kClass> obj{Fake<jobject>()};
+  StringView str{Fake<jstring>()};
+  obj("TakesString", str);
+}
+
+}  // namespace
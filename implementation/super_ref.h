@@ -0,0 +1,70 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_IMPLEMENTATION_SUPER_REF_H_
+#define JNI_BIND_IMPLEMENTATION_SUPER_REF_H_
+
+#include <cstddef>
+#include <utility>
+
+#include "implementation/class_ref.h"
+#include "implementation/id.h"
+#include "implementation/id_type.h"
+#include "implementation/method_selection.h"
+#include "jni_dep.h"
+#include "metaprogramming/invocable_map.h"
+
+namespace jni {
+
+// Invokes a parent class's implementation of methods on an existing object,
+// even if the object's class overrides them (i.e. Java's `super.Foo()`).
+//
+// Obtained through `ObjectRef::Super`, e.g. `obj.Super<kParent>()("Foo", 1)`.
+// Method IDs are cached against the parent class, so they are shared with
+// regular objects of the parent class. This does not own the object and must
+// not outlive the ref it came from.
+template <typename JniT>
+class SuperRef
+    : public metaprogramming::InvocableMap<SuperRef<JniT>,
+                                           JniT::stripped_class_v,
+                                           typename JniT::ClassT,
+                                           &JniT::ClassT::methods_> {
+ public:
+  explicit SuperRef(jobject object) : object_(object) {}
+
+  // Invoked through CRTP from InvocableMap.
+  template <size_t I, typename... Args>
+  auto InvocableMapCall(const char* key, Args&&... args) const {
+    using IdT = Id<JniT, IdType::OVERLOAD_SET, I>;
+    using MethodSelectionForArgs =
+        OverloadSelector<IdT, IdType::OVERLOAD, IdType::OVERLOAD_PARAM,
+                         Args...>;
+
+    static_assert(MethodSelectionForArgs::kIsValidArgSet,
+                  "JNI Error: Invalid argument set.");
+
+    return MethodSelectionForArgs::OverloadRef::template Invoke<true>(
+        ClassRef_t<JniT>::GetAndMaybeLoadClassRef(object_), object_,
+        std::forward<Args>(args)...);
+  }
+
+ private:
+  const jobject object_;
+};
+
+}  // namespace jni
+
+#endif  // JNI_BIND_IMPLEMENTATION_SUPER_REF_H_
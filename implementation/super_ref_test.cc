@@ -0,0 +1,115 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "implementation/jni_helper/fake_test_constants.h"
+#include "jni_bind.h"
+#include "jni_test.h"
+
+namespace {
+
+using ::jni::Class;
+using ::jni::Fake;
+using ::jni::LocalObject;
+using ::jni::Method;
+using ::jni::Nonvirtual;
+using ::jni::Overload;
+using ::jni::Params;
+using ::jni::Return;
+using ::jni::test::AsGlobal;
+using ::jni::test::JniTest;
+using ::testing::_;
+using ::testing::Eq;
+using ::testing::StrEq;
+
+static constexpr Class kParent{
+    "com/jnibind/test/Parent",
+    Method{"Foo", Return<jint>{}, Params<>{}},
+    Method{"Bar", Return<void>{}, Params{jint{}}},
+};
+
+static constexpr Class kChild{
+    "com/jnibind/test/Child",
+    Method{"Foo", Return<jint>{}, Params<>{}},
+    Method{"Baz", Nonvirtual{}, Return<void>{}, Params{jint{}}},
+    Method{"Qux", Nonvirtual{},
+           Overload{Return<jint>{}, Params<>{}},
+           Overload{Return{kParent}, Params{jint{}}}},
+};
+
+TEST_F(JniTest, Nonvirtual_IsTaggedOnTheMethod) {
+  static_assert(!std::get<0>(kChild.methods_).nonvirtual_);
+  static_assert(std::get<1>(kChild.methods_).nonvirtual_);
+  static_assert(std::get<2>(kChild.methods_).nonvirtual_);
+}
+
+TEST_F(JniTest, Nonvirtual_VirtualMethodsStillUseVirtualDispatch) {
+  EXPECT_CALL(*env_, CallIntMethodV(Fake<jobject>(), Fake<jmethodID>(), _));
+  EXPECT_CALL(*env_, CallNonvirtualIntMethodV).Times(0);
+
+  LocalObject<kChild> obj{Fake<jobject>()};
+  obj("Foo");
+}
+
+TEST_F(JniTest, Nonvirtual_TaggedMethodsSkipVirtualDispatch) {
+  EXPECT_CALL(*env_, GetMethodID(_, StrEq("Baz"), StrEq("(I)V")));
+  EXPECT_CALL(*env_, CallNonvirtualVoidMethodV(_, Eq(AsGlobal(Fake<jclass>())),
+                                               Fake<jmethodID>(), _));
+  EXPECT_CALL(*env_, CallVoidMethodV).Times(0);
+
+  LocalObject<kChild> obj{Fake<jobject>()};
+  obj("Baz", 1);
+}
+
+TEST_F(JniTest, Nonvirtual_TaggedOverloadsSkipVirtualDispatch) {
+  EXPECT_CALL(*env_, CallNonvirtualIntMethodV);
+  EXPECT_CALL(*env_, CallNonvirtualObjectMethodV);
+
+  LocalObject<kChild> obj{Fake<jobject>()};
+  obj("Qux");
+  LocalObject<kParent> ret = obj("Qux", 1);
+}
+
+TEST_F(JniTest, Super_CallsTheParentImplementation) {
+  EXPECT_CALL(*env_, GetMethodID(_, StrEq("Foo"), StrEq("()I")));
+  EXPECT_CALL(*env_, CallNonvirtualIntMethodV(_, _, Fake<jmethodID>(), _))
+      .WillOnce(testing::Return(123));
+  EXPECT_CALL(*env_, CallIntMethodV).Times(0);
+
+  LocalObject<kChild> obj{Fake<jobject>()};
+  EXPECT_EQ(obj.Super<kParent>()("Foo"), 123);
+}
+
+TEST_F(JniTest, Super_PassesArgumentsThrough) {
+  EXPECT_CALL(*env_, GetMethodID(_, StrEq("Bar"), StrEq("(I)V")));
+  EXPECT_CALL(*env_, CallNonvirtualVoidMethodV);
+
+  LocalObject<kChild> obj{Fake<jobject>()};
+  obj.Super<kParent>()("Bar", 5);
+}
+
+TEST_F(JniTest, Super_SharesMethodIdsWithTheParentClass) {
+  EXPECT_CALL(*env_, GetMethodID(_, StrEq("Bar"), StrEq("(I)V"))).Times(1);
+
+  LocalObject<kChild> child{Fake<jobject>(1)};
+  LocalObject<kParent> parent{Fake<jobject>(2)};
+
+  child.Super<kParent>()("Bar", 5);
+  parent("Bar", 5);
+}
+
+}  // namespace
@@ -18,6 +18,7 @@
 #define JNI_BIND_IMPLEMENTATION_THREAD_GUARD_H_
 
 #include "implementation/forward_declarations.h"
+#include "implementation/jni_helper/jni_check.h"
 #include "implementation/jvm_ref_base.h"
 #include "jni_dep.h"
 #include "metaprogramming/function_traits.h"
@@ -41,6 +42,7 @@ class ThreadLocalGuardDestructor {
       JavaVM* jvm = JvmRefBase::GetJavaVm();
       if (jvm) {
         jvm->DetachCurrentThread();
+        JniCheck::Detached();
       }
     }
   }
@@ -89,6 +91,7 @@ class ThreadGuard {
                               nullptr);
       thread_local_guard_destructor.detach_thread_when_all_guards_released_ =
           true;
+      JniCheck::Attached();
     }
     // Why not store this locally to ThreadGuard?
     //
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.jnibind;
+
+import jdk.jfr.Category;
+import jdk.jfr.Description;
+import jdk.jfr.Event;
+import jdk.jfr.FlightRecorder;
+import jdk.jfr.Label;
+import jdk.jfr.Name;
+import jdk.jfr.Timespan;
+
+/**
+ * A Java Flight Recorder event for native work done through JNI Bind, so that it appears on the
+ * same timeline as Java.
+ *
+ * <p>This class is never on the classpath. Its bytecode is embedded in native code and defined at
+ * runtime (see implementation/jfr_events.h). Invocations are begun by the constructor and ended by
+ * {@code finish}. Pinned arrays are emitted once the pin is released, as no JNI calls may be made
+ * while an array is pinned critically.
+ */
+@Name("com.jnibind.NativeWork")
+@Label("JNI Bind Native Work")
+@Category("JNI Bind")
+@Description("A sampled call from native code into Java, or a pinned array.")
+public final class JniBindEvent extends Event {
+  static {
+    FlightRecorder.register(JniBindEvent.class);
+  }
+
+  @Label("Name")
+  String name;
+
+  @Label("Pinned Array")
+  boolean pinnedArray;
+
+  @Label("Native Duration")
+  @Timespan(Timespan.NANOSECONDS)
+  long nativeDuration;
+
+  private JniBindEvent(String name, boolean pinnedArray) {
+    this.name = name;
+    this.pinnedArray = pinnedArray;
+    begin();
+  }
+
+  private void finish(long nativeDuration) {
+    this.nativeDuration = nativeDuration;
+    commit();
+  }
+
+  private static void emitPinned(String name, long nativeDuration) {
+    new JniBindEvent(name, true).finish(nativeDuration);
+  }
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.jnibind;
+
+import java.util.function.Consumer;
+import java.util.function.Function;
+import java.util.function.Supplier;
+
+/**
+ * Forwards Java functional interfaces to a native (C++) callable.
+ *
+ * <p>This class is never on the classpath. Its bytecode is embedded in native code and defined at
+ * runtime (see implementation/native_callback.h), and {@code invoke} is bound with RegisterNatives.
+ * {@code handle} is owned by native code, which zeroes it before the callable is destroyed.
+ */
+public final class NativeCallback
+    implements Runnable, Consumer<Object>, Function<Object, Object>, Supplier<Object> {
+  private long handle;
+
+  private NativeCallback(long handle) {
+    this.handle = handle;
+  }
+
+  @Override
+  public void run() {
+    invoke(handle, null);
+  }
+
+  @Override
+  public void accept(Object arg) {
+    invoke(handle, arg);
+  }
+
+  @Override
+  public Object apply(Object arg) {
+    return invoke(handle, arg);
+  }
+
+  @Override
+  public Object get() {
+    return invoke(handle, null);
+  }
+
+  private static native Object invoke(long handle, Object arg);
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.jnibind.test;
+
+import static com.google.common.truth.Truth.assertThat;
+
+import org.junit.AfterClass;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.junit.runners.JUnit4;
+
+@RunWith(JUnit4.class)
+public final class EmbeddedClassTest {
+  static {
+    System.load(
+        System.getenv("JAVA_RUNFILES")
+            + "/__main__/javatests/com/jnibind/test/libembedded_class_test_jni.so");
+  }
+
+  public EmbeddedClassTest() {
+    jniSetup();
+  }
+
+  @AfterClass
+  public static void doShutDown() {
+    jniTearDown();
+  }
+
+  static native void jniSetup();
+
+  static native void jniTearDown();
+
+  static native long nativeSumWithEmbeddedHelper(long a, long b, long c);
+
+  @Test
+  public void embeddedClassIsDefinedOnStartup() throws Exception {
+    assertThat(Class.forName("com.jnibind.test.EmbeddedHelper")).isNotNull();
+  }
+
+  @Test
+  public void embeddedClassIsCallable() {
+    assertThat(nativeSumWithEmbeddedHelper(1, 2, 3)).isEqualTo(6);
+  }
+}
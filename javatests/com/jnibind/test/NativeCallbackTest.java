@@ -0,0 +1,83 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.jnibind.test;
+
+import static com.google.common.truth.Truth.assertThat;
+import static org.junit.Assert.assertThrows;
+
+import java.util.function.Function;
+import org.junit.AfterClass;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.junit.runners.JUnit4;
+
+@RunWith(JUnit4.class)
+public final class NativeCallbackTest {
+  static {
+    System.load(
+        System.getenv("JAVA_RUNFILES")
+            + "/__main__/javatests/com/jnibind/test/libnative_callback_test_jni.so");
+  }
+
+  public NativeCallbackTest() {
+    jniSetup();
+  }
+
+  @AfterClass
+  public static void doShutDown() {
+    jniTearDown();
+  }
+
+  static native void jniSetup();
+
+  static native void jniTearDown();
+
+  static native int nativeRunCallbackNTimes(int n);
+
+  static native Object nativeApplyIdentity(Object arg);
+
+  static native Runnable nativeCreateAndDestroyRunnable();
+
+  // Called from native.
+  static void runNTimes(Runnable runnable, int n) {
+    for (int i = 0; i < n; ++i) {
+      runnable.run();
+    }
+  }
+
+  // Called from native.
+  static Object applyTo(Function<Object, Object> function, Object arg) {
+    return function.apply(arg);
+  }
+
+  @Test
+  public void runnableInvokesNativeCallable() {
+    assertThat(nativeRunCallbackNTimes(5)).isEqualTo(5);
+  }
+
+  @Test
+  public void functionReturnsNativeResult() {
+    Object arg = new Object();
+    assertThat(nativeApplyIdentity(arg)).isSameInstanceAs(arg);
+  }
+
+  @Test
+  public void callbackThrowsAfterNativeDestruction() {
+    Runnable runnable = nativeCreateAndDestroyRunnable();
+    assertThrows(IllegalStateException.class, runnable::run);
+  }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+
+#include "javatests/com/jnibind/test/embedded_helper_class_bytes.h"
+#include "jni_bind.h"
+
+namespace {
+
+using ::jni::Array;
+using ::jni::ArrayView;
+using ::jni::Class;
+using ::jni::EmbeddedClass;
+using ::jni::LocalArray;
+using ::jni::Method;
+using ::jni::Params;
+using ::jni::Return;
+using ::jni::Static;
+using ::jni::StaticRef;
+
+static std::unique_ptr<jni::JvmRef<jni::kDefaultJvm>> jvm;
+
+// clang-format off
+inline constexpr Class kEmbeddedHelper{
+    "com/jnibind/test/EmbeddedHelper",
+    Static{
+        Method{"sum", Return<jlong>{}, Params{Array<jlong>{}}},
+    },
+};
+// clang-format on
+
+inline const EmbeddedClass kEmbeddedHelperClass{
+    kEmbeddedHelper, jni::kEmbeddedHelperClassBytes};
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* pjvm, void* reserved) {
+  return JNI_VERSION_1_6;
+}
+
+JNIEXPORT void JNICALL
+Java_com_jnibind_test_EmbeddedClassTest_jniSetup(JNIEnv* env, jclass) {
+  jvm.reset(new jni::JvmRef<jni::kDefaultJvm>{env});
+}
+
+JNIEXPORT void JNICALL
+Java_com_jnibind_test_EmbeddedClassTest_jniTearDown(JNIEnv* env, jclass) {
+  jvm = nullptr;
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_jnibind_test_EmbeddedClassTest_nativeSumWithEmbeddedHelper(
+    JNIEnv* env, jclass, jlong a, jlong b, jlong c) {
+  LocalArray<jlong> values{3};
+  {
+    ArrayView<jlong> pin = values.Pin();
+    pin.ptr()[0] = a;
+    pin.ptr()[1] = b;
+    pin.ptr()[2] = c;
+  }
+
+  return StaticRef<kEmbeddedHelper>{}("sum", values);
+}
+
+}  // extern "C"
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+
+#include "implementation/native_callback.h"
+#include "jni_bind.h"
+
+namespace {
+
+using ::jni::Class;
+using ::jni::kJavaLangObject;
+using ::jni::kJavaLangRunnable;
+using ::jni::kJavaUtilFunctionFunction;
+using ::jni::Method;
+using ::jni::NativeCallback;
+using ::jni::Params;
+using ::jni::Return;
+using ::jni::Static;
+using ::jni::StaticRef;
+
+static std::unique_ptr<jni::JvmRef<jni::kDefaultJvm>> jvm;
+
+// clang-format off
+inline constexpr Class kNativeCallbackTest{
+    "com/jnibind/test/NativeCallbackTest",
+    Static{
+        Method{"runNTimes", Return{}, Params{kJavaLangRunnable, jint{}}},
+        Method{"applyTo", Return{kJavaLangObject},
+               Params{kJavaUtilFunctionFunction, kJavaLangObject}},
+    },
+};
+// clang-format on
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* pjvm, void* reserved) {
+  return JNI_VERSION_1_6;
+}
+
+JNIEXPORT void JNICALL
+Java_com_jnibind_test_NativeCallbackTest_jniSetup(JNIEnv* env, jclass) {
+  jvm.reset(new jni::JvmRef<jni::kDefaultJvm>{env});
+}
+
+JNIEXPORT void JNICALL
+Java_com_jnibind_test_NativeCallbackTest_jniTearDown(JNIEnv* env, jclass) {
+  jvm = nullptr;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_jnibind_test_NativeCallbackTest_nativeRunCallbackNTimes(JNIEnv* env,
+                                                                 jclass,
+                                                                 jint n) {
+  jint count = 0;
+  NativeCallback<kJavaLangRunnable> runnable{[&count] { ++count; }};
+
+  StaticRef<kNativeCallbackTest>{}("runNTimes", runnable.Get(), n);
+
+  return count;
+}
+
+JNIEXPORT jobject JNICALL
+Java_com_jnibind_test_NativeCallbackTest_nativeApplyIdentity(JNIEnv* env,
+                                                             jclass,
+                                                             jobject arg) {
+  NativeCallback<kJavaUtilFunctionFunction> identity{
+      [](jobject obj) { return obj; }};
+
+  return StaticRef<kNativeCallbackTest>{}("applyTo", identity.Get(), arg)
+      .Release();
+}
+
+JNIEXPORT jobject JNICALL
+Java_com_jnibind_test_NativeCallbackTest_nativeCreateAndDestroyRunnable(
+    JNIEnv* env, jclass) {
+  jobject runnable_local = nullptr;
+  {
+    NativeCallback<kJavaLangRunnable> runnable{[] {}};
+    runnable_local = env->NewLocalRef(static_cast<jobject>(runnable));
+  }
+
+  return runnable_local;
+}
+
+}  // extern "C"
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// C++20 named module for JNI Bind.  `import jni_bind;` is equivalent to
+// `#include "jni_bind.h"` except that the headers are parsed once, when the
+// module interface is precompiled, rather than in every translation unit.
+//
+// Modules do not export macros, so JNI_BIND_C_ENTRYPOINT, JNI_BIND_NATIVE and
+// friends are only available by including "jni_bind.h" (or <jni.h> for
+// JNIEXPORT/JNICALL).
+module;
+
+#include "jni_bind.h"
+
+export module jni_bind;
+
+// JNI types (declared in the global namespace by <jni.h>).
+export {
+  using ::jboolean;
+  using ::jbyte;
+  using ::jchar;
+  using ::jshort;
+  using ::jint;
+  using ::jlong;
+  using ::jfloat;
+  using ::jdouble;
+  using ::jsize;
+
+  using ::jobject;
+  using ::jclass;
+  using ::jthrowable;
+  using ::jstring;
+  using ::jarray;
+  using ::jbooleanArray;
+  using ::jbyteArray;
+  using ::jcharArray;
+  using ::jshortArray;
+  using ::jintArray;
+  using ::jlongArray;
+  using ::jfloatArray;
+  using ::jdoubleArray;
+  using ::jobjectArray;
+
+  using ::jweak;
+  using ::jvalue;
+  using ::jfieldID;
+  using ::jmethodID;
+
+  using ::JavaVM;
+  using ::JNIEnv;
+}
+
+export namespace jni {
+
+// Static definitions.
+using ::jni::Array;
+using ::jni::Class;
+using ::jni::ClassLoader;
+using ::jni::Constructor;
+using ::jni::EmbeddedClass;
+using ::jni::Field;
+using ::jni::Final;
+using ::jni::Jvm;
+using ::jni::LoadedBy;
+using ::jni::Method;
+using ::jni::Nonvirtual;
+using ::jni::Overload;
+using ::jni::Params;
+using ::jni::Rank;
+using ::jni::Return;
+using ::jni::Self;
+using ::jni::Static;
+using ::jni::SupportedClassSet;
+
+using ::jni::kDefaultClassLoader;
+using ::jni::kDefaultJvm;
+using ::jni::kNoClassSpecified;
+using ::jni::kNullClassLoader;
+
+using ::jni::JniUserDefinedCorpusTag;
+
+// Convenience definitions for system libraries.
+using ::jni::kJavaIoInputStream;
+using ::jni::kJavaIoOutputStream;
+using ::jni::kJavaLangClass;
+using ::jni::kJavaLangClassLoader;
+using ::jni::kJavaLangObject;
+using ::jni::kJavaLangRunnable;
+using ::jni::kJavaLangString;
+using ::jni::kJavaLangSystem;
+using ::jni::kJavaUtilFunctionConsumer;
+using ::jni::kJavaUtilFunctionFunction;
+using ::jni::kJavaUtilFunctionSupplier;
+using ::jni::kJavaUtilList;
+
+// Dynamic definitions.
+using ::jni::AllocateUninitialized;
+using ::jni::Construct;
+using ::jni::ArrayRefView;
+using ::jni::ArrayView;
+using ::jni::Batcher;
+using ::jni::Enum;
+using ::jni::GlobalClassLoader;
+using ::jni::GlobalObject;
+using ::jni::GlobalString;
+using ::jni::IdentityHashMap;
+using ::jni::JavaInputStreamReader;
+using ::jni::JavaOutputStreamWriter;
+using ::jni::JfrEvents;
+using ::jni::JniCheck;
+using ::jni::JvmRef;
+using ::jni::LocalArray;
+using ::jni::LocalClassLoader;
+using ::jni::LocalObject;
+using ::jni::LocalString;
+using ::jni::NativeEntry;
+using ::jni::ObjectView;
+using ::jni::ReadInto;
+using ::jni::RegisterNatives;
+using ::jni::StaticRef;
+using ::jni::StringView;
+using ::jni::ThreadGuard;
+using ::jni::ToByteArray;
+using ::jni::UtfStringView;
+
+// Native entry results.
+using ::jni::Exception;
+using ::jni::Result;
+
+// Promotion tags.
+using ::jni::AdoptGlobal;
+using ::jni::AdoptLocal;
+using ::jni::NewRef;
+using ::jni::PromoteToGlobal;
+
+// Comparison operators are free functions and must be visible to ADL.
+using ::jni::operator==;
+using ::jni::operator!=;
+
+// Kernels over primitive arrays.
+namespace kernels {
+using ::jni::kernels::CriticalArray;
+using ::jni::kernels::Dot;
+using ::jni::kernels::Histogram;
+using ::jni::kernels::MinMax;
+using ::jni::kernels::ParallelDot;
+using ::jni::kernels::ParallelSum;
+using ::jni::kernels::PinCritical;
+using ::jni::kernels::Sort;
+using ::jni::kernels::Sum;
+}  // namespace kernels
+
+}  // namespace jni
@@ -33,6 +33,7 @@
 #include "implementation/class_loader.h"
 #include "implementation/constructor.h"
 #include "implementation/default_class_loader.h"
+#include "implementation/embedded_class.h"
 #include "implementation/field.h"
 #include "implementation/forward_declarations.h"
 #include "implementation/id.h"
@@ -51,23 +52,37 @@
 #include "implementation/supported_class_set.h"
 
 // Convenience headers for system libraries.
+#include "class_defs/java_io_classes.h"
 #include "class_defs/java_lang_classes.h"
 #include "class_defs/java_util_classes.h"
+#include "class_defs/java_util_function_classes.h"
 
 // Headers for dynamic definitions.
+#include "implementation/allocate_object.h"
+#include "implementation/array_ref_view.h"
 #include "implementation/array_view.h"
+#include "implementation/batcher.h"
+#include "implementation/byte_array_fragments.h"
+#include "implementation/enum.h"
 #include "implementation/global_class_loader.h"
 #include "implementation/global_object.h"
 #include "implementation/global_string.h"
+#include "implementation/identity_hash_map.h"
+#include "implementation/java_stream.h"
+#include "implementation/jfr_events.h"
 #include "implementation/jvm_ref.h"
+#include "implementation/kernels.h"
 #include "implementation/local_array.h"
 #include "implementation/local_array_string.h"
 #include "implementation/local_class_loader.h"
 #include "implementation/local_object.h"
 #include "implementation/local_string.h"
+#include "implementation/native_entry.h"
+#include "implementation/object_view.h"
 #include "implementation/promotion_mechanics.h"
 #include "implementation/promotion_mechanics_tags.h"
 #include "implementation/ref_base.h"
+#include "implementation/string_view.h"
 
 // These headers require Jni Bind is fully bootstrapped.
 #include "implementation/find_class_fallback.h"
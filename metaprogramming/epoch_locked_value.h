@@ -0,0 +1,72 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_BIND_METAPROGRAMMING_EPOCH_LOCKED_VALUE_H_
+#define JNI_BIND_METAPROGRAMMING_EPOCH_LOCKED_VALUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+namespace jni::metaprogramming {
+
+// Like `DoubleLockedValue`, except that the value is stored alongside the
+// epoch it was initialised in. Loads against any other epoch invoke the lambda
+// again, so every instance is invalidated at once by advancing the epoch,
+// without visiting (or even knowing of) the instances.
+//
+// Epochs must be non-zero. As with `DoubleLockedValue`, a lambda returning
+// T{0} is not cached and is retried on the next load.
+//
+// This class is thread-safe.  Loads in the current epoch are two atomic loads.
+template <typename T_>
+class EpochLockedValue {
+ public:
+  template <typename Lambda>
+  inline T_ LoadAndMaybeInit(std::size_t epoch, Lambda lambda) {
+    // Typical case, value initialised this epoch, perform cheap load.
+    // `value_` is published before `epoch_`, so acquiring `epoch_` suffices.
+    if (epoch_.load(std::memory_order_acquire) == epoch) {
+      return value_.load(std::memory_order_relaxed);
+    }
+
+    // Value was stale (or uninitialised), perform heavy-weight lock.
+    std::lock_guard<std::mutex> lock_guard{lock_};
+
+    // Check another thread didn't race to lock before.
+    if (epoch_.load(std::memory_order_relaxed) == epoch) {
+      return value_.load(std::memory_order_relaxed);
+    }
+
+    // Perform the potentially expensive initialisation and return.
+    T_ return_value = lambda();
+    if (return_value != T_{0}) {
+      value_.store(return_value, std::memory_order_relaxed);
+      epoch_.store(epoch, std::memory_order_release);
+    }
+
+    return return_value;
+  }
+
+ private:
+  std::atomic<T_> value_ = {0};
+  std::atomic<std::size_t> epoch_ = {0};
+  std::mutex lock_;
+};
+
+}  // namespace jni::metaprogramming
+
+#endif  // JNI_BIND_METAPROGRAMMING_EPOCH_LOCKED_VALUE_H_
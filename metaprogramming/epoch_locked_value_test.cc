@@ -0,0 +1,87 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "epoch_locked_value.h"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using ::jni::metaprogramming::EpochLockedValue;
+
+TEST(EpochLockedValue, InitialisesOncePerEpoch) {
+  int a = 1;
+  auto lambda{[&]() { return a++; }};
+  EpochLockedValue<int> epoch_locked_value;
+
+  EXPECT_EQ(1, epoch_locked_value.LoadAndMaybeInit(1, lambda));
+  EXPECT_EQ(1, epoch_locked_value.LoadAndMaybeInit(1, lambda));
+  EXPECT_EQ(2, epoch_locked_value.LoadAndMaybeInit(2, lambda));
+  EXPECT_EQ(2, epoch_locked_value.LoadAndMaybeInit(2, lambda));
+}
+
+TEST(EpochLockedValue, HasNoCrossTalkAcrossInstances) {
+  EpochLockedValue<int> epoch_locked_value_1;
+  EpochLockedValue<int> epoch_locked_value_2;
+
+  EXPECT_EQ(1, epoch_locked_value_1.LoadAndMaybeInit(1, []() { return 1; }));
+  EXPECT_EQ(2, epoch_locked_value_2.LoadAndMaybeInit(1, []() { return 2; }));
+  EXPECT_EQ(1, epoch_locked_value_1.LoadAndMaybeInit(1, []() { return 3; }));
+}
+
+TEST(EpochLockedValue, DoesNotCacheZero) {
+  int calls = 0;
+  auto lambda{[&]() {
+    ++calls;
+    return 0;
+  }};
+  EpochLockedValue<int> epoch_locked_value;
+
+  EXPECT_EQ(0, epoch_locked_value.LoadAndMaybeInit(1, lambda));
+  EXPECT_EQ(0, epoch_locked_value.LoadAndMaybeInit(1, lambda));
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(7, epoch_locked_value.LoadAndMaybeInit(1, []() { return 7; }));
+}
+
+TEST(EpochLockedValue, InitialisesOnceAcrossThreads) {
+  std::atomic<int> calls{0};
+  EpochLockedValue<int> epoch_locked_value;
+
+  for (std::size_t epoch = 1; epoch <= 3; ++epoch) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+      threads.emplace_back([&]() {
+        EXPECT_EQ(epoch_locked_value.LoadAndMaybeInit(
+                      epoch, [&]() { return ++calls; }),
+                  static_cast<int>(epoch));
+      });
+    }
+
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  EXPECT_EQ(calls, 3);
+}
+
+}  // namespace
@@ -22,6 +22,7 @@
 #include <utility>
 
 #include "interleave.h"
+#include "string_literal_equal.h"
 #include "tuple_from_size.h"
 #include "tuple_manipulation.h"
 #include "type_of_nth_element.h"
@@ -96,6 +97,10 @@ template <typename CrtpBase, const auto& tup_container_v,
 class QueryableMapEntry {
  public:
 #if __clang__
+  // Evaluated once per entry (as opposed to once per call site).
+  static constexpr const char* kName =
+      std::get<I>(tup_container_v.*nameable_member).name_;
+
   // This function blurs the distinction between type and value space.  The
   // clang extension allows the key to be wrapped in a constexpr way.  This
   // allows for string to string comparison based on the static value the class
@@ -106,9 +111,7 @@ class QueryableMapEntry {
   // the constexpr-ness of the string can't be propagated.  This essentially
   // means you get one shot at defining the function.
   constexpr auto operator[](const char* key) __attribute__((
-      enable_if(std::string_view(key) ==
-                    std::get<I>(tup_container_v.*nameable_member).name_,
-                ""))) {
+      enable_if(StringLiteralEqual(key, kName), ""))) {
     static_assert(std::is_base_of_v<QueryableMapEntry, CrtpBase>,
                   "You must derive from the invocable map.");
 
@@ -116,9 +119,7 @@ class QueryableMapEntry {
   }
 
   constexpr bool Contains(const char* key) __attribute__((
-      enable_if(std::string_view(key) ==
-                    std::get<I>(tup_container_v.*nameable_member).name_,
-                ""))) {
+      enable_if(StringLiteralEqual(key, kName), ""))) {
     return true;
   }
 #else
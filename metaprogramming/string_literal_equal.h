@@ -0,0 +1,39 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef JNI_BIND_METAPROGRAMMING_STRING_LITERAL_EQUAL_H_
+#define JNI_BIND_METAPROGRAMMING_STRING_LITERAL_EQUAL_H_
+
+namespace jni::metaprogramming {
+
+// Compares two null terminated strings, returning on the first mismatch.
+//
+// This is intended for constant evaluation in `enable_if` attributes, where it
+// is evaluated once per candidate, per call site.  Unlike comparing through
+// `std::string_view`, neither string is measured first, so a mismatched
+// candidate typically costs a single character comparison.
+constexpr bool StringLiteralEqual(const char* lhs, const char* rhs) {
+  for (; *lhs != '\0'; ++lhs, ++rhs) {
+    if (*lhs != *rhs) {
+      return false;
+    }
+  }
+
+  return *rhs == '\0';
+}
+
+}  // namespace jni::metaprogramming
+
+#endif  // JNI_BIND_METAPROGRAMMING_STRING_LITERAL_EQUAL_H_
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "metaprogramming/string_literal_equal.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using ::jni::metaprogramming::StringLiteralEqual;
+
+namespace {
+
+static_assert(StringLiteralEqual("", ""));
+static_assert(StringLiteralEqual("a", "a"));
+static_assert(StringLiteralEqual("method0", "method0"));
+
+static_assert(!StringLiteralEqual("", "a"));
+static_assert(!StringLiteralEqual("a", ""));
+static_assert(!StringLiteralEqual("a", "b"));
+static_assert(!StringLiteralEqual("method0", "method1"));
+static_assert(!StringLiteralEqual("method", "method0"));
+static_assert(!StringLiteralEqual("method0", "method"));
+
+static constexpr const char* kName = "Foo";
+static_assert(StringLiteralEqual(kName, "Foo"));
+static_assert(!StringLiteralEqual(kName, "Fo"));
+
+TEST(StringLiteralEqual, MatchesAtRuntime) {
+  const char* foo = "Foo";
+  EXPECT_TRUE(StringLiteralEqual(foo, "Foo"));
+  EXPECT_FALSE(StringLiteralEqual(foo, "Bar"));
+}
+
+}  // namespace